@@ -0,0 +1,143 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A* with octile distance against A* with the ALT heuristic, 8-way movement.
+ * "explored" counts the cells that got a cost. Total path costs must match.
+ *
+ * Then the time it takes to build the landmark tables against saving and
+ * loading them.
+ *
+ * Usage: pinder_bench_alt [SIZE] [QUERIES] [LANDMARKS]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf, std::remove */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "Landmarks.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_QUERIES     50
+#define DEFAULT_LANDMARKS   8
+
+#define TABLE_FILE          "pinder_bench_alt.bin"
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+struct Totals {
+    long explored = 0;
+    double cost = 0;
+    double ms = 0;
+};
+
+template<typename Heuristic>
+Totals run(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    IndexedHeap<Location, double> frontier;
+    Totals totals;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+
+        Clock::time_point t0 = Clock::now();
+        a_star_search(view, workspace, heuristic, frontier);
+        totals.ms += elapsed_ms(t0);
+
+        totals.explored += workspace.size();
+
+        if (workspace.visited(query.second))
+            totals.cost += workspace.costSoFar(query.second);
+    }
+
+    return totals;
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+    int n_landmarks = (argc > 3) ? atoi(argv[3]) : DEFAULT_LANDMARKS;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1 || n_landmarks < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES] [LANDMARKS]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+    Landmarks<graph::EightWay> landmarks(board);
+
+    printf("%dx%d boards, %d queries, %d landmarks, 8-way movement\n",
+        size, size, n_queries, n_landmarks);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        Clock::time_point t0 = Clock::now();
+        landmarks.build(n_landmarks, workspace);
+        double build_ms = elapsed_ms(t0);
+
+        t0 = Clock::now();
+        bool saved = landmarks.save(TABLE_FILE);
+        double save_ms = elapsed_ms(t0);
+
+        t0 = Clock::now();
+        bool loaded = landmarks.load(TABLE_FILE);
+        double load_ms = elapsed_ms(t0);
+
+        std::remove(TABLE_FILE);
+
+        Totals octile = run(board, queries, workspace, Octile());
+        Totals alt = run(board, queries, workspace,
+            AltHeuristic<graph::EightWay>(landmarks));
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("  %-8s %12s %12s %10s\n", "", "explored", "cost", "ms");
+        printf("  %-8s %12ld %12.1f %10.1f\n", "octile",
+            octile.explored, octile.cost, octile.ms);
+        printf("  %-8s %12ld %12.1f %10.1f\n", "ALT",
+            alt.explored, alt.cost, alt.ms);
+        printf("  tables: build %.1f ms, save %.1f ms%s, load %.1f ms%s\n",
+            build_ms, save_ms, saved ? "" : " (failed)",
+            load_ms, loaded ? "" : " (failed)");
+    }
+
+    return 0;
+}
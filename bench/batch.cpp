@@ -0,0 +1,141 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput of BatchSearch (A*, 8-way movement) as threads are added, from
+ * one up to THREADS (one per hardware thread by default). Each pool answers
+ * the batch once before it is timed, so workspaces are already allocated.
+ * Costs must match the single thread ones.
+ *
+ * CSV, if given, gets the SearchStats of every single thread query.
+ *
+ * Usage: pinder_bench_batch [SIZE] [QUERIES] [THREADS] [CSV]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <fstream>          /* std::ofstream */
+#include <thread>           /* std::thread */
+#include <vector>           /* std::vector */
+
+#include "bench_maps.h"
+
+#include "BatchSearch.h"
+
+
+#define DEFAULT_SIZE        512
+#define DEFAULT_QUERIES     2000
+
+
+typedef std::chrono::steady_clock Clock;
+typedef BatchSearch<graph::EightWay> Batch;
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+    int max_threads = (argc > 3)
+        ? atoi(argv[3]) : (int) std::thread::hardware_concurrency();
+
+    if (max_threads < 1)
+        max_threads = 1;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES] [THREADS] [CSV]\n",
+            argv[0]);
+        return 1;
+    }
+
+    std::ofstream csv;
+
+    if (argc > 4) {
+        csv.open(argv[4]);
+
+        if (!csv) {
+            fprintf(stderr, "Can not write to %s\n", argv[4]);
+            return 1;
+        }
+
+        csv << "map,query,found,cost,";
+        search_stats_csv_header(csv);
+        csv << '\n';
+    }
+
+    // 1, 2, 4, ... and max_threads
+    std::vector<int> thread_counts;
+
+    for (int threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+
+    thread_counts.push_back(max_threads);
+
+    graph::Board board(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement, %u hardware threads\n",
+        size, size, n_queries, std::thread::hardware_concurrency());
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        std::vector<Batch::Result> expected, results;
+        double single = 0;
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("  %8s %12s %10s %10s\n",
+            "threads", "queries/s", "speedup", "mismatch");
+
+        for (int threads : thread_counts) {
+            Batch batch(board, threads);
+
+            batch.run(queries, results);
+
+            Clock::time_point t0 = Clock::now();
+            batch.run(queries, results);
+            double s = std::chrono::duration<double>(Clock::now() - t0)
+                .count();
+
+            if (threads == 1) {
+                expected = results;
+                single = s;
+
+                for (std::size_t i = 0; csv && i < results.size(); ++i) {
+                    csv << bench_map_name(map) << ',' << i << ','
+                        << results[i].found << ',' << results[i].cost << ',';
+                    search_stats_csv(csv, results[i].stats);
+                    csv << '\n';
+                }
+            }
+
+            int mismatch = 0;
+
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                if (results[i].found != expected[i].found
+                    || results[i].cost != expected[i].cost)
+                {
+                    ++mismatch;
+                }
+            }
+
+            printf("  %8d %12.0f %10.2f %10d\n", threads,
+                n_queries / s, single / s, mismatch);
+        }
+    }
+
+    return 0;
+}
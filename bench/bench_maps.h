@@ -0,0 +1,194 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BENCH_MAPS_H
+#define BENCH_MAPS_H    1
+
+#include <cstddef>          /* std::size_t */
+#include <random>           /* std::mt19937 */
+#include <string>           /* std::string */
+#include <utility>          /* std::pair */
+#include <vector>           /* std::vector */
+
+#include "Board.h"
+
+/*
+ * Synthetic maps shared by the benchmarks. Every map is generated from a
+ * fixed seed, so numbers are comparable between runs and between commits.
+ */
+
+#define BENCH_ROOM_SIZE     16
+#define BENCH_CORRIDOR_SIZE 4
+
+enum class BenchMap {
+    open,           // No walls
+    scattered,      // 20% random walls
+    weighted,       // 20% random walls, 25% weights
+    rooms,          // BENCH_ROOM_SIZE rooms joined by 2 cell wide doors
+    corridors       // One long corridor, snaking every BENCH_CORRIDOR_SIZE
+};
+
+static const BenchMap BENCH_MAPS[] = {
+    BenchMap::open, BenchMap::scattered, BenchMap::weighted, BenchMap::rooms,
+    BenchMap::corridors
+};
+
+inline const char* bench_map_name(const BenchMap map)
+{
+    switch (map) {
+    case BenchMap::open:        return "open";
+    case BenchMap::scattered:   return "scattered";
+    case BenchMap::weighted:    return "weighted";
+    case BenchMap::rooms:       return "rooms";
+    case BenchMap::corridors:   return "corridors";
+    }
+
+    return "?";
+}
+
+inline void bench_fill_map(graph::Board& board, const BenchMap map)
+{
+    int rows = board.getRows(), columns = board.getColumns();
+
+    std::mt19937 rng(rows * 31 + columns);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    board.clear();
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            int roll = percent(rng);
+
+            switch (map) {
+            case BenchMap::scattered:
+                if (roll < 20)
+                    board.setWall({x, y});
+                break;
+
+            case BenchMap::weighted:
+                if (roll < 20)
+                    board.setWall({x, y});
+                else if (roll < 45)
+                    board.setWeight({x, y});
+                break;
+
+            case BenchMap::rooms:
+                if (x % BENCH_ROOM_SIZE == 0 || y % BENCH_ROOM_SIZE == 0)
+                    board.setWall({x, y});
+                break;
+
+            case BenchMap::corridors:
+                // The wall is open at the east and west end, alternately
+                if (y % BENCH_CORRIDOR_SIZE == BENCH_CORRIDOR_SIZE - 1
+                    && ((y / BENCH_CORRIDOR_SIZE) % 2
+                        ? x >= 2 : x < columns - 2))
+                {
+                    board.setWall({x, y});
+                }
+                break;
+
+            case BenchMap::open:    /* Fallsthrough */
+            default:
+                break;
+            }
+        }
+    }
+
+    if (map == BenchMap::rooms) {
+        std::uniform_int_distribution<int> door(1, BENCH_ROOM_SIZE - 3);
+
+        // One door on the east and one on the south wall of every room
+        for (int y = 0; y < rows; y += BENCH_ROOM_SIZE) {
+            for (int x = 0; x < columns; x += BENCH_ROOM_SIZE) {
+                int east = door(rng), south = door(rng);
+
+                for (int i = 0; i < 2; ++i) {
+                    board.setEmpty({x + BENCH_ROOM_SIZE, y + east + i});
+                    board.setEmpty({x + south + i, y + BENCH_ROOM_SIZE});
+                }
+            }
+        }
+    }
+}
+
+// count free (start, goal) pairs, the same ones for the same board
+inline std::vector<std::pair<graph::Location, graph::Location>>
+bench_queries(const graph::Board& board, const int count)
+{
+    std::vector<std::pair<graph::Location, graph::Location>> queries;
+
+    std::mt19937 rng(count);
+    std::uniform_int_distribution<int> column(0, board.getColumns() - 1);
+    std::uniform_int_distribution<int> row(0, board.getRows() - 1);
+
+    while ((int) queries.size() < count) {
+        graph::Location start = {column(rng), row(rng)};
+        graph::Location goal = {column(rng), row(rng)};
+
+        if (board.passable(start) && board.passable(goal) && start != goal)
+            queries.push_back({start, goal});
+    }
+
+    return queries;
+}
+
+// Counts the nodes a search expands (calls to neighbors()), and how many of
+// those were cells already expanded before
+template<typename Graph>
+class CountingGraph {
+public:
+    typedef typename Graph::location_t location_t;
+
+    CountingGraph(const Graph& graph_)
+    : graph(graph_), expanded(0), duplicates(0),
+      seen((std::size_t) graph_.getRows() * graph_.getColumns(), false) {}
+
+    graph::Neighbors neighbors(const location_t position) const
+    {
+        std::size_t i = (std::size_t) position.y * getColumns() + position.x;
+
+        ++expanded;
+
+        if (seen[i])
+            ++duplicates;
+
+        seen[i] = true;
+
+        return graph.neighbors(position);
+    }
+
+    double cost(const location_t from, const location_t to) const
+    {
+        return graph.cost(from, to);
+    }
+
+    int getRows() const { return graph.getRows(); }
+    int getColumns() const { return graph.getColumns(); }
+    const location_t& getStart() const { return graph.getStart(); }
+    const location_t& getGoal() const { return graph.getGoal(); }
+
+    const Graph graph;
+
+    mutable long expanded;
+    mutable long duplicates;
+
+private:
+    mutable std::vector<bool> seen;
+};
+
+#endif /* BENCH_MAPS_H */
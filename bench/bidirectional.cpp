@@ -0,0 +1,139 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Dijkstra and A* against their bidirectional versions, 8-way movement.
+ * "explored" counts the cells that got a cost (both searches' for the
+ * bidirectional ones). Total path costs must match.
+ *
+ * Usage: pinder_bench_bidirectional [SIZE] [QUERIES]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        512
+#define DEFAULT_QUERIES     50
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+struct Totals {
+    long explored = 0;
+    double cost = 0;
+    double ms = 0;
+};
+
+template<typename Heuristic>
+void run(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace,
+    Workspace& backward,
+    Heuristic heuristic,
+    Totals& single,
+    Totals& both
+)
+{
+    IndexedHeap<Location, double> frontier, backward_frontier;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+
+        Clock::time_point t0 = Clock::now();
+        a_star_search(view, workspace, heuristic, frontier);
+        Clock::time_point t1 = Clock::now();
+
+        single.ms += std::chrono::duration<double, std::milli>(t1 - t0)
+            .count();
+        single.explored += workspace.size();
+
+        if (workspace.visited(query.second))
+            single.cost += workspace.costSoFar(query.second);
+
+        t0 = Clock::now();
+        bidirectional_a_star_search(
+            view, workspace, backward, heuristic, frontier, backward_frontier
+        );
+        t1 = Clock::now();
+
+        both.ms += std::chrono::duration<double, std::milli>(t1 - t0)
+            .count();
+        both.explored += workspace.size() + backward.size();
+
+        if (workspace.visited(query.second))
+            both.cost += workspace.costSoFar(query.second);
+    }
+}
+
+static void print(const char* name, const Totals& totals)
+{
+    printf("  %-16s %12ld %12.1f %10.1f\n", name,
+        totals.explored, totals.cost, totals.ms);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size), backward(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement\n", size, size,
+        n_queries);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        Totals dijkstra, bi_dijkstra, a_star, bi_a_star;
+
+        // a_star_search with a ZeroHeuristic is Dijkstra with an early exit
+        run(board, queries, workspace, backward, ZeroHeuristic(),
+            dijkstra, bi_dijkstra);
+        run(board, queries, workspace, backward, Octile(),
+            a_star, bi_a_star);
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("  %-16s %12s %12s %10s\n", "",
+            "explored", "cost", "ms");
+
+        print("Dijkstra", dijkstra);
+        print("bidir. Dijkstra", bi_dijkstra);
+        print("A*", a_star);
+        print("bidir. A*", bi_a_star);
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Unweighted all-cell BFS from one start: breadth_first_search against
+ * BitboardBfs, for each movement policy. Export is the extra cost of
+ * recovering every parent and distance into a workspace, which must match
+ * breadth_first_search's distances, with each parent a neighbor one step
+ * closer.
+ *
+ * Usage: pinder_bench_bitbfs [SIZE] [REPEATS]
+ */
+
+#include <algorithm>        /* std::find */
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BitboardBfs.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        2048
+#define DEFAULT_REPEATS     3
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+template<typename Movement>
+static void run(
+    const char* name, const graph::Board& board, const Location start,
+    const int repeats, Workspace& workspace, Workspace& exported
+)
+{
+    typedef graph::BoardView<Movement> View;
+
+    // A goal off the board, so both searches flood everything
+    View view(board, start, {-1, -1});
+    BitboardBfs<Movement> bitboard(board);
+
+    Clock::time_point t0 = Clock::now();
+
+    for (int i = 0; i < repeats; ++i)
+        breadth_first_search(view, workspace);
+
+    double bfs_ms = elapsed_ms(t0) / repeats;
+
+    t0 = Clock::now();
+
+    for (int i = 0; i < repeats; ++i)
+        bitboard.search(start);
+
+    double bitboard_ms = elapsed_ms(t0) / repeats;
+
+    t0 = Clock::now();
+    bitboard.exportTo(exported);
+    double export_ms = elapsed_ms(t0);
+
+    std::size_t mismatch = 0;
+
+    for (int y = 0; y < board.getRows(); ++y) {
+        for (int x = 0; x < board.getColumns(); ++x) {
+            Location cell = {x, y};
+
+            if (workspace.visited(cell) != exported.visited(cell)) {
+                ++mismatch;
+                continue;
+            }
+
+            if (!exported.visited(cell) || cell == start)
+                continue;
+
+            Location from = exported.cameFrom(cell);
+            auto neighbors = view.neighbors(from);
+
+            if (workspace.costSoFar(cell) != exported.costSoFar(cell)
+                || exported.costSoFar(from) + 1 != exported.costSoFar(cell)
+                || std::find(neighbors.begin(), neighbors.end(), cell)
+                    == neighbors.end())
+            {
+                ++mismatch;
+            }
+        }
+    }
+
+    printf("    %-14s %10.2f %10.2f %8.1fx %10.2f %10zu %9zu\n", name,
+        bfs_ms, bitboard_ms, bfs_ms / bitboard_ms, export_ms,
+        bitboard.countReached(), mismatch);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int repeats = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPEATS;
+
+    if (size < 2 * BENCH_ROOM_SIZE || repeats < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [REPEATS]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size), exported(size, size);
+
+    printf("%dx%d boards, flooding from one cell, mean of %d runs\n",
+        size, size, repeats);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+
+        Location start = bench_queries(board, 1)[0].first;
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("    %-14s %10s %10s %9s %10s %10s %9s\n", "movement",
+            "BFS ms", "bits ms", "speedup", "export ms", "reached",
+            "mismatch");
+
+        run<graph::FourWay>("4-way", board, start, repeats, workspace,
+            exported);
+        run<graph::EightWay>("8-way", board, start, repeats, workspace,
+            exported);
+        run<graph::EightWayNoCornerCutting>("8-way no cut", board, start,
+            repeats, workspace, exported);
+    }
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the dense cell array used by graph::Board with the hash set
+ * layout it replaced.
+ *
+ * Usage: pinder_bench_board [SIZE] [REPEATS]
+ */
+
+#include <algorithm>        /* std::reverse, std::min */
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+#include <unordered_set>    /* std::unordered_set */
+#include <vector>           /* std::vector */
+
+#include "search_algorithm.h"
+#include "Board.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_REPEATS     3
+
+#define WALL_PERCENT        20
+#define WEIGHT_PERCENT      25
+
+
+using graph::Location;
+
+// The previous graph::Board storage, kept here only as a reference point
+class HashSetBoard {
+public:
+    typedef Location location_t;
+
+    HashSetBoard(int rows_, int columns_) : rows(rows_), columns(columns_) {}
+
+    bool in_bounds(const Location position) const
+    {
+        return position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows;
+    }
+
+    bool passable(const Location position) const
+    {
+        return walls.find(position) == walls.end();
+    }
+
+    std::vector<Location> neighbors(const Location position) const
+    {
+        std::vector<Location> results;
+        Location next = {0, 0};
+
+        for (Location direction : graph::EightWay::DIRS) {
+            next.x = position.x + direction.x;
+            next.y = position.y + direction.y;
+
+            if (in_bounds(next) && passable(next))
+                results.push_back(next);
+        }
+
+        if ((position.x + position.y) % 2 == 0)
+            std::reverse(results.begin(), results.end());
+
+        return results;
+    }
+
+    double cost(const Location from, const Location to) const
+    {
+        double weight = weights.find(to) != weights.end() ? 5 : 1;
+
+        return (from.x != to.x && from.y != to.y)
+            ? weight * graph::DIAGONAL_STEP : weight;
+    }
+
+    graph::Board::ElementType getElementTypeAt(const Location position) const
+    {
+        if (walls.find(position) != walls.end())
+            return graph::Board::ElementType::WALL;
+        if (position == start)
+            return graph::Board::ElementType::START;
+        if (position == goal)
+            return graph::Board::ElementType::GOAL;
+        if (weights.find(position) != weights.end())
+            return graph::Board::ElementType::WEIGHT;
+
+        return graph::Board::ElementType::EMPTY;
+    }
+
+    int getRows() const { return rows; }
+    int getColumns() const { return columns; }
+
+    const Location& getStart() const { return start; }
+    const Location& getGoal() const { return goal; }
+
+    // Rough libstdc++ figure: bucket array plus one node per element
+    std::size_t bytes() const
+    {
+        std::size_t node = sizeof(void*) + sizeof(Location) + sizeof(size_t);
+
+        return (walls.bucket_count() + weights.bucket_count()) * sizeof(void*)
+            + (walls.size() + weights.size()) * node;
+    }
+
+    int rows, columns;
+    Location start, goal;
+    std::unordered_set<Location> walls;
+    std::unordered_set<Location> weights;
+};
+
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+template<typename Graph>
+double bench_lookups(const Graph& graph, int size, double& sink)
+{
+    Clock::time_point t0 = Clock::now();
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            Location here = {x, y};
+
+            sink += graph.passable(here)
+                + graph.cost(here, here)
+                + (int) graph.getElementTypeAt(here);
+        }
+    }
+
+    return elapsed_ms(t0);
+}
+
+template<typename Graph>
+double bench_expansions(const Graph& graph, int size, double& sink)
+{
+    Clock::time_point t0 = Clock::now();
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            Location here = {x, y};
+
+            for (Location next : graph.neighbors(here))
+                sink += graph.cost(here, next);
+        }
+    }
+
+    return elapsed_ms(t0);
+}
+
+template<typename Graph>
+double bench_dijkstra(const Graph& graph, double& sink)
+{
+    SearchWorkspace<Location, double> workspace(
+        graph.getRows(), graph.getColumns()
+    );
+
+    Clock::time_point t0 = Clock::now();
+
+    dijkstra_search(graph, workspace);
+
+    double ms = elapsed_ms(t0);
+    sink += workspace.size();
+
+    return ms;
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int repeats = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPEATS;
+
+    if (size < 2 || repeats < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [REPEATS]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board dense(size, size);
+    HashSetBoard hashed(size, size);
+
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    dense.setStart({0, 0});
+    dense.setGoal({size - 1, size - 1});
+    hashed.start = {0, 0};
+    hashed.goal = {size - 1, size - 1};
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            Location here = {x, y};
+            int roll = percent(rng);
+
+            if (dense.isStartGoal(here))
+                continue;
+
+            if (roll < WALL_PERCENT) {
+                dense.setWall(here);
+                hashed.walls.insert(here);
+            }
+            else if (roll < WALL_PERCENT + WEIGHT_PERCENT) {
+                dense.setWeight(here);
+                hashed.weights.insert(here);
+            }
+        }
+    }
+
+    double sink = 0;
+    double best[2][3] = {
+        {1e300, 1e300, 1e300},
+        {1e300, 1e300, 1e300}
+    };
+
+    for (int i = 0; i < repeats; ++i) {
+        best[0][0] = std::min(best[0][0], bench_lookups(hashed, size, sink));
+        best[1][0] = std::min(best[1][0], bench_lookups(dense, size, sink));
+
+        best[0][1] = std::min(best[0][1], bench_expansions(hashed, size, sink));
+        best[1][1] = std::min(best[1][1], bench_expansions(dense, size, sink));
+
+        best[0][2] = std::min(best[0][2], bench_dijkstra(hashed, sink));
+        best[1][2] = std::min(best[1][2], bench_dijkstra(dense, sink));
+    }
+
+    std::size_t dense_bytes = (std::size_t) (size + 2) * (size + 2);
+
+    printf("Board %dx%d, %d%% walls, %d%% weights, best of %d\n\n",
+        size, size, WALL_PERCENT, WEIGHT_PERCENT, repeats);
+    printf("%-10s %12s %14s %12s %12s\n",
+        "layout", "lookups ms", "expansions ms", "dijkstra ms", "memory KiB");
+    printf("%-10s %12.2f %14.2f %12.2f %12zu\n", "hash set",
+        best[0][0], best[0][1], best[0][2], hashed.bytes() / 1024);
+    printf("%-10s %12.2f %14.2f %12.2f %12zu\n", "dense",
+        best[1][0], best[1][1], best[1][2], dense_bytes / 1024);
+
+    // Keeps the compiler from dropping the loops
+    return sink == 0.5 ? 2 : 0;
+}
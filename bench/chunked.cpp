@@ -0,0 +1,206 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ChunkedBoard against graph::Board, A* with 8-way movement: the bench maps
+ * copied cell by cell (costs must match), memory taken by each, then a huge
+ * mostly empty world that a dense board could not hold, searched with a
+ * SparseWorkspace.
+ *
+ * Usage: pinder_bench_chunked [SIZE] [QUERIES]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "ChunkedBoard.h"
+#include "SparseWorkspace.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_QUERIES     50
+
+// Side of the huge world, of the rooms in it and of its wall and weight
+// blocks
+#define WORLD_SIZE          1000000
+#define WORLD_ROOM          256
+#define WORLD_ROOMS         40
+#define WORLD_ROOMS_X       1000
+#define WORLD_ROOMS_Y       1000
+#define WORLD_BLOCK         4096
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+// Total cost of A* over all queries, and the time it took
+template<typename Grid, typename Search>
+static double run(
+    const Grid& grid,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Search& workspace, double& cost
+)
+{
+    IndexedHeap<Location, double> frontier;
+    Clock::time_point t0 = Clock::now();
+
+    cost = 0;
+
+    for (const auto& query : queries) {
+        graph::BoardView<graph::EightWay, Grid> view(
+            grid, query.first, query.second
+        );
+
+        a_star_search(view, workspace, Octile(), frontier);
+
+        if (workspace.visited(query.second))
+            cost += workspace.costSoFar(query.second);
+    }
+
+    return elapsed_ms(t0);
+}
+
+// A row of walled rooms with a door on each side, plus a mountain of walls
+// and a swamp of weights well away from them
+static void build_world(graph::ChunkedBoard& world)
+{
+    for (int i = 0; i < WORLD_ROOMS; ++i) {
+        int x = WORLD_ROOMS_X + i * 2 * WORLD_ROOM, y = WORLD_ROOMS_Y;
+        int half = WORLD_ROOM / 2;
+
+        world.fill({{x, y}, {x + WORLD_ROOM, y + WORLD_ROOM}},
+            graph::Board::ElementType::WALL);
+        world.fill({{x + 1, y + 1}, {x + WORLD_ROOM - 1, y + WORLD_ROOM - 1}},
+            graph::Board::ElementType::EMPTY);
+
+        world.setEmpty({x + half, y});
+        world.setEmpty({x + half, y + WORLD_ROOM - 1});
+        world.setEmpty({x, y + half});
+        world.setEmpty({x + WORLD_ROOM - 1, y + half});
+    }
+
+    int middle = WORLD_SIZE / 2;
+
+    world.fill({{0, middle}, {WORLD_BLOCK, middle + WORLD_BLOCK}},
+        graph::Board::ElementType::WALL);
+    world.fill({{middle, 0}, {middle + WORLD_BLOCK, WORLD_BLOCK}},
+        graph::Board::ElementType::WEIGHT);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement\n", size, size,
+        n_queries);
+    printf("\n  %-10s %12s %12s %12s %12s %9s\n", "", "Board KiB",
+        "chunked KiB", "Board ms", "chunked ms", "mismatch");
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        graph::ChunkedBoard chunked(size, size);
+
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                switch (board.getElementTypeAt({x, y})) {
+                case graph::Board::ElementType::WALL:
+                    chunked.setWall({x, y});
+                    break;
+
+                case graph::Board::ElementType::WEIGHT:
+                    chunked.setWeight({x, y});
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        chunked.compact();
+
+        double board_cost, chunked_cost;
+        double board_ms = run(board, queries, workspace, board_cost);
+        double chunked_ms = run(chunked, queries, workspace, chunked_cost);
+
+        // Board keeps a one cell border of walls around the grid
+        std::size_t board_bytes = (std::size_t) (size + 2) * (size + 2);
+
+        printf("  %-10s %12zu %12zu %12.1f %12.1f %9s\n",
+            bench_map_name(map), board_bytes / 1024,
+            chunked.memoryUsage() / 1024, board_ms, chunked_ms,
+            (board_cost == chunked_cost) ? "0" : "YES");
+    }
+
+    graph::ChunkedBoard world(WORLD_SIZE, WORLD_SIZE);
+
+    Clock::time_point t0 = Clock::now();
+    build_world(world);
+    double build_ms = elapsed_ms(t0);
+
+    // Through every room, door to door
+    int y = WORLD_ROOMS_Y + WORLD_ROOM / 2;
+    Location from = {WORLD_ROOMS_X - WORLD_ROOM, y};
+    Location to = {WORLD_ROOMS_X + WORLD_ROOMS * 2 * WORLD_ROOM, y};
+
+    SparseWorkspace<Location, double> sparse;
+    PriorityQueue<Location, double> frontier;
+    graph::BoardView<graph::EightWay, graph::ChunkedBoard> view(
+        world, from, to
+    );
+
+    t0 = Clock::now();
+    a_star_search(view, sparse, Octile(), frontier);
+    double search_ms = elapsed_ms(t0);
+
+    printf("\n%dx%d world, %d rooms of %dx%d, %dx%d blocks\n",
+        WORLD_SIZE, WORLD_SIZE, WORLD_ROOMS, WORLD_ROOM, WORLD_ROOM,
+        WORLD_BLOCK, WORLD_BLOCK);
+    printf("  built in %.1f ms, %zu KiB in %zu array and %zu uniform tiles\n",
+        build_ms, world.memoryUsage() / 1024, world.countArrayTiles(),
+        world.countUniformTiles());
+    printf("  A* (%d, %d) ~> (%d, %d): cost %.1f, %zu cells visited, %.1f ms\n",
+        from.x, from.y, to.x, to.y,
+        sparse.visited(to) ? sparse.costSoFar(to) : -1.0, sparse.size(),
+        search_ms);
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Queries with no path, 4-way movement on the scattered map (where plenty of
+ * cells are walled in): what A* takes to find out against a component check.
+ *
+ * Then random wall toggles: keeping the components up to date against
+ * labeling the board from scratch. Last, a larger board assigned over the
+ * first one, with a wall toggled before the next query.
+ *
+ * Usage: pinder_bench_components [SIZE] [QUERIES]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "Components.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_QUERIES     50
+
+#define EDITS               10000
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::FourWay> View;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+    IndexedHeap<Location, double> frontier;
+
+    bench_fill_map(board, BenchMap::scattered);
+
+    Clock::time_point t0 = Clock::now();
+    Components<graph::FourWay> components(board);
+    double label_ms = elapsed_ms(t0);
+
+    // The same pairs bench_queries() would give, minus the reachable ones
+    std::vector<std::pair<Location, Location>> queries;
+
+    for (const auto& query : bench_queries(board, 100 * n_queries)) {
+        if ((int) queries.size() < n_queries
+            && !components.connected(query.first, query.second))
+        {
+            queries.push_back(query);
+        }
+    }
+
+    long explored = 0;
+    double a_star_ms = 0, check_ms = 0;
+    int rejected = 0;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+
+        t0 = Clock::now();
+        a_star_search(view, workspace, Manhattan(), frontier);
+        a_star_ms += elapsed_ms(t0);
+
+        explored += workspace.size();
+
+        t0 = Clock::now();
+        rejected += !components.connected(query.first, query.second);
+        check_ms += elapsed_ms(t0);
+    }
+
+    printf("%dx%d scattered board, 4-way movement, %zu queries with no "
+        "path\n\n", size, size, queries.size());
+    printf("  A*                 %10.3f ms (%ld cells explored)\n",
+        a_star_ms, explored);
+    printf("  component check    %10.3f ms (%d rejected)\n",
+        check_ms, rejected);
+
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> cell(0, size - 1);
+
+    std::size_t relabels = components.countRelabels();
+
+    t0 = Clock::now();
+    for (int i = 0; i < EDITS; ++i) {
+        Location position = {cell(rng), cell(rng)};
+
+        board.toggleWall(position);
+        components.connected(position, position);
+    }
+    double edits_ms = elapsed_ms(t0);
+
+    relabels = components.countRelabels() - relabels;
+
+    printf("\n%d wall toggles, a query after each one\n\n", EDITS);
+    printf("  full labeling      %10.3f ms\n", label_ms);
+    printf("  per edit           %10.3f ms (%zu full relabels)\n",
+        edits_ms / EDITS, relabels);
+
+    // A larger board assigned over this one: edits to cells past the old
+    // size wait for the relabel the next query does
+    int grown = size + BENCH_ROOM_SIZE;
+    graph::Board larger(grown, grown);
+
+    bench_fill_map(larger, BenchMap::scattered);
+
+    relabels = components.countRelabels();
+
+    t0 = Clock::now();
+    board = larger;
+    board.toggleWall({grown - 1, grown - 1});
+    bool corner = components.component({grown - 1, grown - 1}) >= 0;
+    double resize_ms = elapsed_ms(t0);
+
+    relabels = components.countRelabels() - relabels;
+
+    printf("\nGrown to %dx%d, a wall toggle and a query after it\n\n",
+        grown, grown);
+    printf("  resize             %10.3f ms (%zu full relabels, corner %s)\n",
+        resize_ms, relabels, corner ? "free" : "walled");
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replanning after single cell edits, 8-way movement: D* Lite repairing its
+ * last plan against A* searching again from scratch. Edits toggle a wall on
+ * a random cell, or on a random cell of the current path (which always
+ * changes the answer). Costs must match after every edit.
+ *
+ * Usage: pinder_bench_dstar [SIZE] [EDITS]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cmath>            /* std::fabs */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "DStarLite.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_EDITS       200
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+struct Totals {
+    double a_star_ms = 0;
+    double replan_ms = 0;
+    long expanded = 0;
+    int mismatches = 0;
+};
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_edits = (argc > 2) ? atoi(argv[2]) : DEFAULT_EDITS;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_edits < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [EDITS]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+    IndexedHeap<Location, double> frontier;
+    DStarLite<graph::EightWay> planner(board);
+
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> cell(0, size - 1);
+
+    printf("%dx%d boards, %d edits of each kind, 8-way movement\n", size,
+        size, n_edits);
+    printf("\n%-10s %-6s %12s %12s %14s %10s\n", "", "edits",
+        "A* ms/edit", "D* ms/edit", "D* expanded", "mismatch");
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+
+        // The longest of a few queries
+        Location start = {}, goal = {};
+        double longest = -1;
+
+        for (const auto& query : bench_queries(board, 10)) {
+            View view(board, query.first, query.second);
+            a_star_search(view, workspace, Octile(), frontier);
+
+            if (workspace.visited(query.second)
+                && workspace.costSoFar(query.second) > longest)
+            {
+                longest = workspace.costSoFar(query.second);
+                start = query.first;
+                goal = query.second;
+            }
+        }
+
+        View view(board, start, goal);
+
+        Clock::time_point t0 = Clock::now();
+        planner.plan(start, goal);
+        double first_ms = elapsed_ms(t0);
+
+        for (int on_path = 0; on_path < 2; ++on_path) {
+            Totals totals;
+            std::vector<Location> path;
+
+            for (int i = 0; i < n_edits; ++i) {
+                Location position = {cell(rng), cell(rng)};
+
+                if (on_path && planner.path(path) && path.size() > 2) {
+                    std::uniform_int_distribution<std::size_t> pick(
+                        1, path.size() - 2
+                    );
+                    position = path[pick(rng)];
+                }
+
+                board.toggleWall(position);
+
+                t0 = Clock::now();
+                bool found = planner.plan(start, goal);
+                totals.replan_ms += elapsed_ms(t0);
+                totals.expanded += planner.countExpanded();
+
+                t0 = Clock::now();
+                a_star_search(view, workspace, Octile(), frontier);
+                totals.a_star_ms += elapsed_ms(t0);
+
+                if (found != workspace.visited(goal)
+                    || (found && std::fabs(planner.costToGoal(start)
+                        - workspace.costSoFar(goal)) > 1e-6))
+                {
+                    ++totals.mismatches;
+                }
+            }
+
+            printf("%-10s %-6s %12.3f %12.3f %14ld %10d\n",
+                on_path ? "" : bench_map_name(map),
+                on_path ? "path" : "random",
+                totals.a_star_ms / n_edits, totals.replan_ms / n_edits,
+                totals.expanded / n_edits, totals.mismatches);
+        }
+
+        printf("%-10s first plan %.1f ms\n", "", first_ms);
+    }
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Many agents heading for one goal, 8-way movement: one A* per agent against
+ * one FlowField for all of them, followed step by step. Total path costs
+ * must match.
+ *
+ * Usage: pinder_bench_flow [SIZE] [AGENTS]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cmath>            /* std::fabs */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "FlowField.h"
+
+
+#define DEFAULT_SIZE        512
+#define DEFAULT_AGENTS      200
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_agents = (argc > 2) ? atoi(argv[2]) : DEFAULT_AGENTS;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_agents < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [AGENTS]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+    IndexedHeap<Location, double> frontier;
+    FlowField flow;
+
+    printf("%dx%d boards, %d agents, 8-way movement\n", size, size, n_agents);
+    printf("\n  %-10s %12s %12s %12s %12s %9s\n", "", "A* ms",
+        "field ms", "walk ms", "per agent", "mismatch");
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+
+        // Every agent shares the first query's goal
+        auto queries = bench_queries(board, n_agents);
+        Location goal = queries[0].second;
+
+        double a_star_cost = 0, flow_cost = 0;
+
+        Clock::time_point t0 = Clock::now();
+
+        for (const auto& query : queries) {
+            a_star_search(View(board, query.first, goal), workspace,
+                Octile(), frontier);
+
+            if (workspace.visited(goal))
+                a_star_cost += workspace.costSoFar(goal);
+        }
+
+        double a_star_ms = elapsed_ms(t0);
+
+        t0 = Clock::now();
+        flow.build(View(board, goal, goal));
+        double build_ms = elapsed_ms(t0);
+
+        // Agents walk the field one O(1) lookup per step
+        t0 = Clock::now();
+
+        for (const auto& query : queries) {
+            Location current = query.first;
+
+            if (!flow.reachable(current))
+                continue;
+
+            while (current != goal) {
+                Location next = flow.next(current);
+
+                flow_cost += board.cost(current, next);
+                current = next;
+            }
+        }
+
+        double walk_ms = elapsed_ms(t0);
+
+        printf("  %-10s %12.1f %12.1f %12.1f %12.4f %9s\n",
+            bench_map_name(map), a_star_ms, build_ms, walk_ms,
+            (build_ms + walk_ms) / n_agents,
+            (std::fabs(a_star_cost - flow_cost) < 1e-6 * a_star_cost)
+                ? "0" : "YES");
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Frontier behaviour of A* (octile, 8-way) and Dijkstra with a lazy binary
+ * heap against the indexed 4-ary heap: how many nodes are expanded, how many
+ * of those expansions repeat a cell, how many stale entries are popped and
+ * how large the frontier gets.
+ *
+ * Usage: pinder_bench_frontier [SIZE] [QUERIES]
+ */
+
+#include <algorithm>        /* std::max */
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <utility>          /* std::forward */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        512
+#define DEFAULT_QUERIES     50
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+// Keeps track of the largest size and the number of get()
+template<typename Queue>
+class MeasuredQueue : public Queue {
+public:
+    MeasuredQueue() : gets(0), peak(0) {}
+
+    template<typename... Args>
+    void put(Args&&... args)
+    {
+        Queue::put(std::forward<Args>(args)...);
+        peak = std::max(peak, Queue::size());
+    }
+
+    Location get()
+    {
+        ++gets;
+        return Queue::get();
+    }
+
+    long gets;
+    std::size_t peak;
+};
+
+struct Totals {
+    long expanded = 0;
+    long duplicates = 0;
+    long stale = 0;
+    std::size_t peak = 0;
+    double ms = 0;
+};
+
+template<typename Queue>
+Totals run(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace,
+    const bool a_star
+)
+{
+    Totals totals;
+    MeasuredQueue<Queue> frontier;
+
+    for (const auto& query : queries) {
+        CountingGraph<View> graph(View(board, query.first, query.second));
+
+        frontier.gets = 0;
+
+        Clock::time_point t0 = Clock::now();
+
+        if (a_star)
+            a_star_search(graph, workspace, Octile(), frontier);
+        else
+            dijkstra_search(graph, workspace, frontier);
+
+        totals.ms += std::chrono::duration<double, std::milli>(
+            Clock::now() - t0
+        ).count();
+
+        totals.expanded += graph.expanded;
+        totals.duplicates += graph.duplicates;
+        // The goal is popped and closed, but never expanded
+        totals.stale += frontier.gets - graph.expanded
+            - workspace.closed(query.second);
+    }
+
+    totals.peak = frontier.peak;
+
+    return totals;
+}
+
+static void print(const char* name, const Totals& totals)
+{
+    printf("  %-14s %12ld %12ld %12ld %12zu %10.1f\n", name,
+        totals.expanded, totals.duplicates, totals.stale, totals.peak,
+        totals.ms);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement\n", size, size, n_queries);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        printf("\n%s\n  %-14s %12s %12s %12s %12s %10s\n", bench_map_name(map),
+            "", "expanded", "duplicates", "stale pops", "peak", "ms");
+
+        for (int a_star = 1; a_star >= 0; --a_star) {
+            printf("  %s\n", a_star ? "A*" : "Dijkstra");
+
+            print("binary heap", run<PriorityQueue<Location, double>>(
+                board, queries, workspace, a_star));
+            print("indexed heap", run<IndexedHeap<Location, double>>(
+                board, queries, workspace, a_star));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Nodes expanded by A* with each heuristic on the benchmark maps, 8-way
+ * movement. "sqrt" is the heuristic the TUI used before the octile one.
+ *
+ * Usage: pinder_bench_heuristics [SIZE] [QUERIES]
+ */
+
+#include <cmath>            /* std::sqrt */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi, std::abs */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        256
+#define DEFAULT_QUERIES     100
+
+
+using graph::Location;
+
+struct SqrtManhattan {
+    inline double operator() (const Location a, const Location b) const
+    {
+        return std::sqrt(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+    }
+};
+
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+template<typename Heuristic>
+long expansions(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    long total = 0;
+
+    for (const auto& query : queries) {
+        CountingGraph<View> graph(View(board, query.first, query.second));
+
+        a_star_search(graph, workspace, heuristic);
+        total += graph.expanded;
+    }
+
+    return total;
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("A* expansions, %dx%d boards, %d queries, 8-way movement\n\n",
+        size, size, n_queries);
+    printf("%-10s %12s %12s %12s %12s %12s\n", "map",
+        "zero", "sqrt", "euclidean", "chebyshev", "octile");
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        printf("%-10s %12ld %12ld %12ld %12ld %12ld\n", bench_map_name(map),
+            expansions(board, queries, workspace, ZeroHeuristic()),
+            expansions(board, queries, workspace, SqrtManhattan()),
+            expansions(board, queries, workspace, Euclidean()),
+            expansions(board, queries, workspace, Chebyshev()),
+            expansions(board, queries, workspace, Octile())
+        );
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A* against HPA*, 8-way movement. HPA* paths may cost a bit more than the
+ * optimal ones: "cost" is the ratio of its total path cost to A*'s.
+ *
+ * Then the time it takes to build the abstract graph against refreshing it
+ * after a wall is toggled.
+ *
+ * Usage: pinder_bench_hpa [SIZE] [QUERIES] [CLUSTER SIZE]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+
+#include "bench_maps.h"
+
+#include "hpa_star.h"
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE            2048
+#define DEFAULT_QUERIES         50
+#define DEFAULT_CLUSTER_SIZE    16
+
+#define GRAPH_EDITS             200
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+    int cluster_size = (argc > 3) ? atoi(argv[3]) : DEFAULT_CLUSTER_SIZE;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1 || cluster_size < 2) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES] [CLUSTER SIZE]\n",
+            argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+    IndexedHeap<Location, double> frontier;
+
+    printf("%dx%d boards, %d queries, %dx%d clusters, 8-way movement\n",
+        size, size, n_queries, cluster_size, cluster_size);
+    printf("\n%-10s %10s %12s %10s %8s %10s %10s\n", "",
+        "nodes", "A* explored", "A* ms", "HPA* ms", "cost", "build ms");
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        Clock::time_point t0 = Clock::now();
+        HpaGraph<graph::EightWay> hpa(board, cluster_size);
+        hpa.refresh(workspace);
+        double build_ms = elapsed_ms(t0);
+
+        long explored = 0;
+        double a_star_ms = 0, hpa_ms = 0;
+        double a_star_cost = 0, hpa_cost = 0;
+
+        for (const auto& query : queries) {
+            View view(board, query.first, query.second);
+
+            t0 = Clock::now();
+            a_star_search(view, workspace, Octile(), frontier);
+            a_star_ms += elapsed_ms(t0);
+
+            explored += workspace.size();
+
+            if (workspace.visited(query.second))
+                a_star_cost += workspace.costSoFar(query.second);
+
+            t0 = Clock::now();
+            hpa_star_search(view, hpa, workspace, Octile());
+            hpa_ms += elapsed_ms(t0);
+
+            if (workspace.visited(query.second))
+                hpa_cost += workspace.costSoFar(query.second);
+        }
+
+        printf("%-10s %10zu %12ld %10.1f %8.1f %10.4f %10.1f\n",
+            bench_map_name(map), hpa.countNodes(), explored, a_star_ms,
+            hpa_ms, (a_star_cost > 0) ? hpa_cost / a_star_cost : 1.0,
+            build_ms);
+
+        // Each edit only rebuilds the clusters around it
+        std::mt19937 rng(size);
+        std::uniform_int_distribution<int> cell(0, size - 1);
+
+        t0 = Clock::now();
+        for (int i = 0; i < GRAPH_EDITS; ++i) {
+            board.toggleWall({cell(rng), cell(rng)});
+            hpa.refresh(workspace);
+        }
+
+        printf("%-10s %10s %12s %10s %8s %10s %10.3f per edit\n",
+            "", "", "", "", "", "", elapsed_ms(t0) / GRAPH_EDITS);
+    }
+
+    return 0;
+}
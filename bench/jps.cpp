@@ -0,0 +1,203 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A* against Jump Point Search and JPS+ on the unweighted benchmark maps,
+ * with and without corner cutting. All the columns of total path cost must
+ * match. "visited" counts the cells that got a cost, i.e. the search's
+ * footprint.
+ *
+ * Then the time it takes to build a JPS+ table against patching it after a
+ * wall is toggled.
+ *
+ * Usage: pinder_bench_jps [SIZE] [QUERIES] [TABLE SIZE]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        1024
+#define DEFAULT_QUERIES     50
+#define DEFAULT_TABLE_SIZE  4096
+
+#define TABLE_EDITS         200
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+
+enum class Search {
+    a_star,
+    jps,
+    jps_plus
+};
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+struct Totals {
+    long visited = 0;
+    double cost = 0;
+    double ms = 0;
+};
+
+template<typename Movement>
+Totals run(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    const JumpTable<Movement>& table,
+    Workspace& workspace,
+    const Search search
+)
+{
+    typedef graph::BoardView<Movement> View;
+
+    Totals totals;
+    IndexedHeap<Location, double> frontier;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+
+        Clock::time_point t0 = Clock::now();
+
+        switch (search) {
+        case Search::a_star:
+            a_star_search(view, workspace, Octile(), frontier);
+            break;
+
+        case Search::jps:
+            jps_search(view, workspace, Octile(), frontier);
+            break;
+
+        case Search::jps_plus:
+            jps_plus_search(view, table, workspace, Octile(), frontier);
+            break;
+        }
+
+        totals.ms += elapsed_ms(t0);
+
+        totals.visited += workspace.size();
+
+        if (workspace.visited(query.second))
+            totals.cost += workspace.costSoFar(query.second);
+    }
+
+    return totals;
+}
+
+template<typename Movement>
+void compare(
+    const char* name,
+    graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace
+)
+{
+    JumpTable<Movement> table(board);
+
+    Totals a_star = run(board, queries, table, workspace, Search::a_star);
+    Totals jps = run(board, queries, table, workspace, Search::jps);
+    Totals plus = run(board, queries, table, workspace, Search::jps_plus);
+
+    printf("  %-12s %10ld %10ld %10.1f %10.1f %10.1f %8.1f %8.1f %8.1f\n",
+        name, a_star.visited, jps.visited, a_star.cost, jps.cost, plus.cost,
+        a_star.ms, jps.ms, plus.ms);
+}
+
+// Full build against incremental updates, on a board of rooms
+template<typename Movement>
+void bench_table(const char* name, const int size)
+{
+    graph::Board board(size, size);
+    bench_fill_map(board, BenchMap::rooms);
+
+    Clock::time_point t0 = Clock::now();
+    JumpTable<Movement> table(board);
+    double build_ms = elapsed_ms(t0);
+
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> coordinate(0, size - 1);
+
+    t0 = Clock::now();
+
+    for (int i = 0; i < TABLE_EDITS; ++i)
+        board.toggleWall({coordinate(rng), coordinate(rng)});
+
+    double update_ms = elapsed_ms(t0) / TABLE_EDITS;
+
+    printf("  %-12s %12.1f %12.3f\n", name, build_ms, update_ms);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+    int table_size = (argc > 3) ? atoi(argv[3]) : DEFAULT_TABLE_SIZE;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1 || table_size < 2) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES] [TABLE SIZE]\n",
+            argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("%dx%d boards, %d queries, octile heuristic\n", size, size,
+        n_queries);
+
+    for (BenchMap map : BENCH_MAPS) {
+        // Jump Point Search assumes uniform costs
+        if (map == BenchMap::weighted)
+            continue;
+
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("  %-12s %10s %10s %10s %10s %10s %8s %8s %8s\n", "",
+            "A* visited", "JPS visit.", "A* cost", "JPS cost", "JPS+ cost",
+            "A* ms", "JPS ms", "JPS+ ms");
+
+        compare<graph::EightWay>("8-way", board, queries, workspace);
+        compare<graph::EightWayNoCornerCutting>(
+            "no corners", board, queries, workspace
+        );
+    }
+
+    printf("\nJPS+ table, %dx%d rooms, average of %d wall toggles\n",
+        table_size, table_size, TABLE_EDITS);
+    printf("  %-12s %12s %12s\n", "", "build ms", "update ms");
+
+    bench_table<graph::EightWay>("8-way", table_size);
+    bench_table<graph::EightWayNoCornerCutting>("no corners", table_size);
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Loading a board from a text map against opening the binary format with
+ * mmap, and A* (8-way) on the loaded graph::Board against the MappedBoard.
+ * Costs must match.
+ *
+ * Usage: pinder_bench_mapped [SIZE] [QUERIES]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf, remove */
+#include <cstdlib>          /* atoi */
+#include <fstream>          /* std::ifstream, std::ofstream */
+#include <memory>           /* std::unique_ptr */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "MapFile.h"
+#include "MappedBoard.h"
+
+
+#define DEFAULT_SIZE        2048
+#define DEFAULT_QUERIES     10
+
+#define TEXT_FILE           "pinder_bench_mapped.txt"
+#define BINARY_FILE         "pinder_bench_mapped.bin"
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+// Total cost and time of A* over all queries
+template<typename View>
+static double run(
+    const std::vector<std::pair<Location, Location>>& queries,
+    const View& base, Workspace& workspace, double& cost
+)
+{
+    IndexedHeap<Location, double> frontier;
+    Clock::time_point t0 = Clock::now();
+
+    cost = 0;
+
+    for (const auto& query : queries) {
+        View view(base.getGrid(), query.first, query.second);
+
+        a_star_search(view, workspace, Octile(), frontier);
+
+        if (workspace.visited(query.second))
+            cost += workspace.costSoFar(query.second);
+    }
+
+    return elapsed_ms(t0);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement\n", size, size,
+        n_queries);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        {
+            std::ofstream text(TEXT_FILE);
+            graph::write_text_map(text, board);
+        }
+
+        Clock::time_point t0 = Clock::now();
+        graph::MappedBoard::save(BINARY_FILE, board);
+        double save_ms = elapsed_ms(t0);
+
+        t0 = Clock::now();
+        std::ifstream text(TEXT_FILE);
+        std::unique_ptr<graph::Board> loaded = graph::read_text_map(text);
+        double text_ms = elapsed_ms(t0);
+
+        graph::MappedBoard mapped;
+
+        t0 = Clock::now();
+        bool opened = mapped.open(BINARY_FILE);
+        double open_ms = elapsed_ms(t0);
+
+        if (!loaded || !opened) {
+            fprintf(stderr, "Can not load the %s map back\n",
+                bench_map_name(map));
+            return 1;
+        }
+
+        double board_cost, mapped_cost;
+
+        graph::BoardView<graph::EightWay> board_view(*loaded);
+        graph::BoardView<graph::EightWay, graph::MappedBoard>
+            mapped_view(mapped);
+
+        double board_ms = run(queries, board_view, workspace, board_cost);
+        double mapped_ms = run(queries, mapped_view, workspace, mapped_cost);
+
+        printf("\n%s\n", bench_map_name(map));
+        printf("  text map load %10.2f ms\n", text_ms);
+        printf("  binary save   %10.2f ms\n", save_ms);
+        printf("  mmap open     %10.3f ms\n", open_ms);
+        printf("  A* on Board       %10.1f ms  cost %.1f\n",
+            board_ms, board_cost);
+        printf("  A* on MappedBoard %10.1f ms  cost %.1f%s\n",
+            mapped_ms, mapped_cost,
+            (board_cost == mapped_cost) ? "" : "  MISMATCH");
+    }
+
+    remove(TEXT_FILE);
+    remove(BINARY_FILE);
+
+    return 0;
+}
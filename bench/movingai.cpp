@@ -0,0 +1,262 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Every scenario of a MovingAI .scen file (https://movingai.com/benchmarks)
+ * with each search, 8-way movement without corner cutting as the benchmark
+ * expects. Per engine and per band of buckets: latency percentiles, mean
+ * expanded nodes and how many path costs differ from the optimal one in the
+ * file. BFS counts steps, so its paths are not expected to match.
+ *
+ * MAP defaults to the file named in the scenarios, next to SCEN.
+ *
+ * Usage: pinder_bench_movingai SCEN [MAP]
+ */
+
+#include <algorithm>        /* std::sort, std::max */
+#include <chrono>           /* std::chrono */
+#include <cmath>            /* std::fabs */
+#include <cstdio>           /* printf */
+#include <fstream>          /* std::ifstream */
+#include <memory>           /* std::unique_ptr */
+#include <string>           /* std::string */
+#include <vector>           /* std::vector */
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+#include "MapFile.h"
+
+
+// Bands of buckets printed per engine, at most
+#define MAX_BANDS           8
+
+// Optimal lengths in .scen files have 8 decimals
+#define COST_TOLERANCE      1e-4
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWayNoCornerCutting> View;
+
+// Counts calls to neighbors(), that is expansions for breadth_first_search
+class CountingView : public View {
+public:
+    explicit CountingView(const View& view) : View(view) {}
+
+    inline graph::Neighbors neighbors(const Location position) const
+    {
+        ++expanded;
+        return View::neighbors(position);
+    }
+
+    mutable long expanded = 0;
+};
+
+// Counts pops, that is expansions for searches with an IndexedHeap
+class CountingFrontier : public IndexedHeap<Location, double> {
+public:
+    inline Location get()
+    {
+        ++expanded;
+        return IndexedHeap<Location, double>::get();
+    }
+
+    long expanded = 0;
+};
+
+// Runs a search and returns the nodes it expanded
+typedef long (*Engine)(CountingView&, Workspace&, CountingFrontier&);
+
+static long run_bfs(CountingView& view, Workspace& ws, CountingFrontier&)
+{
+    breadth_first_search(view, ws);
+    return view.expanded;
+}
+
+static long run_dijkstra(
+    CountingView& view, Workspace& ws, CountingFrontier& frontier
+)
+{
+    dijkstra_search(view, ws, frontier);
+    return frontier.expanded;
+}
+
+static long run_a_star(
+    CountingView& view, Workspace& ws, CountingFrontier& frontier
+)
+{
+    a_star_search(view, ws, Octile(), frontier);
+    return frontier.expanded;
+}
+
+static long run_jps(
+    CountingView& view, Workspace& ws, CountingFrontier& frontier
+)
+{
+    jps_search(view, ws, Octile(), frontier);
+    return frontier.expanded;
+}
+
+static const struct {
+    const char* name;
+    Engine run;
+} ENGINES[] = {
+    {"BFS", run_bfs},
+    {"Dijkstra", run_dijkstra},
+    {"A*", run_a_star},
+    {"JPS", run_jps}
+};
+
+struct Sample {
+    double us;
+    long expanded;
+    bool matches;
+};
+
+static void print_band(const char* label, std::vector<Sample> samples)
+{
+    if (samples.empty())
+        return;
+
+    std::sort(samples.begin(), samples.end(),
+        [](const Sample& a, const Sample& b) { return a.us < b.us; });
+
+    auto percentile = [&](std::size_t p) {
+        return samples[std::min(samples.size() - 1, samples.size() * p / 100)]
+            .us;
+    };
+
+    double expanded = 0;
+    int mismatch = 0;
+
+    for (const Sample& sample : samples) {
+        expanded += sample.expanded;
+        mismatch += !sample.matches;
+    }
+
+    printf("  %-10s %8zu %10.1f %10.1f %10.1f %10.1f %10.0f %9d\n", label,
+        samples.size(), percentile(50), percentile(90), percentile(99),
+        samples.back().us, expanded / samples.size(), mismatch);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s SCEN [MAP]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<graph::Scenario> scenarios;
+    std::ifstream scen_file(argv[1]);
+
+    if (!graph::read_movingai_scenarios(scen_file, scenarios)
+        || scenarios.empty())
+    {
+        fprintf(stderr, "Can not read scenarios %s\n", argv[1]);
+        return 1;
+    }
+
+    std::string map_name;
+
+    if (argc > 2) {
+        map_name = argv[2];
+    }
+    else {
+        std::string scen = argv[1], map = scenarios[0].map;
+        std::size_t slash = scen.find_last_of('/');
+
+        map_name = (slash == std::string::npos)
+            ? "" : scen.substr(0, slash + 1);
+        map_name += map.substr(map.find_last_of('/') + 1);
+    }
+
+    std::ifstream map_file(map_name);
+    std::unique_ptr<graph::Board> board = graph::read_movingai_map(map_file);
+
+    if (!board) {
+        fprintf(stderr, "Can not read map %s\n", map_name.c_str());
+        return 1;
+    }
+
+    int max_bucket = 0;
+
+    for (const graph::Scenario& scenario : scenarios)
+        max_bucket = std::max(max_bucket, scenario.bucket);
+
+    int band_width = max_bucket / MAX_BANDS + 1;
+    int n_bands = max_bucket / band_width + 1;
+
+    Workspace workspace(board->getRows(), board->getColumns());
+    CountingFrontier frontier;
+    std::vector<Location> path;
+
+    printf("%s: %dx%d, %zu scenarios, buckets 0-%d\n", map_name.c_str(),
+        board->getColumns(), board->getRows(), scenarios.size(), max_bucket);
+
+    for (const auto& engine : ENGINES) {
+        std::vector<std::vector<Sample>> bands(n_bands);
+        std::vector<Sample> all;
+
+        for (const graph::Scenario& scenario : scenarios) {
+            CountingView view(View(*board, scenario.start, scenario.goal));
+            Sample sample;
+
+            frontier.expanded = 0;
+            path.clear();
+
+            Clock::time_point t0 = Clock::now();
+            sample.expanded = engine.run(view, workspace, frontier);
+            sample.us = std::chrono::duration<double, std::micro>(
+                Clock::now() - t0).count();
+
+            // What the path costs, whatever the search counted as cost
+            double cost = -1;
+
+            if (search_reconstruct_path(view, workspace, path)) {
+                cost = 0;
+
+                for (std::size_t i = 1; i < path.size(); ++i)
+                    cost += board->cost(path[i - 1], path[i]);
+            }
+
+            sample.matches = std::fabs(cost - scenario.optimal)
+                <= COST_TOLERANCE * std::max(1.0, scenario.optimal);
+
+            bands[scenario.bucket / band_width].push_back(sample);
+            all.push_back(sample);
+        }
+
+        printf("\n%s\n", engine.name);
+        printf("  %-10s %8s %10s %10s %10s %10s %10s %9s\n", "buckets",
+            "queries", "p50 us", "p90 us", "p99 us", "max us", "expanded",
+            "mismatch");
+
+        for (int b = 0; b < n_bands; ++b) {
+            int last = std::min(max_bucket, (b + 1) * band_width - 1);
+            std::string label = std::to_string(b * band_width) + "-"
+                + std::to_string(last);
+
+            print_band(label.c_str(), bands[b]);
+        }
+
+        print_band("all", all);
+    }
+
+    return 0;
+}
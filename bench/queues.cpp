@@ -0,0 +1,139 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the frontier queues. First a hold model (pop the smallest item,
+ * push it back a few units later) at frontier sizes from 10^3 up to
+ * 10^MAX_EXP, then full Dijkstra floods of a weighted map.
+ *
+ * Usage: pinder_bench_queues [MAX_EXP] [MAP_SIZE]
+ */
+
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+#include <random>           /* std::mt19937 */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_MAX_EXP     7
+#define DEFAULT_MAP_SIZE    1024
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed_ms(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+}
+
+// Nanoseconds per put() + get() pair
+template<template<typename, typename> class Queue>
+double hold(const long size)
+{
+    Queue<Location, double> queue;
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> step(1, 5);
+    std::uniform_int_distribution<int> start(0, 99);
+
+    // Priorities are stored in the items so they can be pushed back
+    for (long i = 0; i < size; ++i) {
+        int priority = start(rng);
+        queue.put({priority, 0}, priority);
+    }
+
+    Clock::time_point t0 = Clock::now();
+
+    for (long i = 0; i < size; ++i) {
+        Location item = queue.get();
+
+        item.x += step(rng);
+        queue.put(item, item.x);
+    }
+
+    while (!queue.empty())
+        queue.get();
+
+    return elapsed_ms(t0) * 1e6 / (2 * size);
+}
+
+template<template<typename, typename> class Queue, typename Movement>
+double flood(const graph::Board& board, SearchWorkspace<Location, double>& ws)
+{
+    graph::BoardView<Movement> view(board, {0, 0}, {-1, -1});
+
+    Clock::time_point t0 = Clock::now();
+
+    dijkstra_search<Queue>(view, ws);
+
+    return elapsed_ms(t0);
+}
+
+int main(int argc, char* argv[])
+{
+    int max_exp = (argc > 1) ? atoi(argv[1]) : DEFAULT_MAX_EXP;
+    int map_size = (argc > 2) ? atoi(argv[2]) : DEFAULT_MAP_SIZE;
+
+    if (max_exp < 3 || map_size < 2 * BENCH_ROOM_SIZE) {
+        fprintf(stderr, "Usage: %s [MAX_EXP] [MAP_SIZE]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Hold model, ns per put + get\n\n");
+    printf("%-10s %14s %14s %14s\n",
+        "frontier", "binary heap", "bucket queue", "radix heap");
+
+    for (long size = 1000, e = 3; e <= max_exp; size *= 10, ++e) {
+        printf("%-10ld %14.1f %14.1f %14.1f\n", size,
+            hold<PriorityQueue>(size),
+            hold<BucketQueue>(size),
+            hold<RadixHeap>(size)
+        );
+    }
+
+    graph::Board board(map_size, map_size);
+    SearchWorkspace<Location, double> workspace(map_size, map_size);
+
+    bench_fill_map(board, BenchMap::weighted);
+
+    printf("\nDijkstra flood of a %dx%d weighted map, ms\n\n",
+        map_size, map_size);
+    printf("%-10s %14s %14s %14s\n",
+        "movement", "binary heap", "bucket queue", "radix heap");
+
+    printf("%-10s %14.1f %14.1f %14.1f\n", "4-way",
+        flood<PriorityQueue, graph::FourWay>(board, workspace),
+        flood<BucketQueue, graph::FourWay>(board, workspace),
+        flood<RadixHeap, graph::FourWay>(board, workspace)
+    );
+
+    // Diagonal steps cost sqrt(2): not for the bucket queue
+    printf("%-10s %14.1f %14s %14.1f\n", "8-way",
+        flood<PriorityQueue, graph::EightWay>(board, workspace),
+        "-",
+        flood<RadixHeap, graph::EightWay>(board, workspace)
+    );
+
+    return 0;
+}
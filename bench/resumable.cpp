@@ -0,0 +1,185 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * What it costs to run a search in slices, as an animation or a game loop
+ * would, instead of in one go: total time, number of slices and the longest
+ * one, for whole searches and for steps of a fixed number of expansions or
+ * of a time budget.
+ *
+ * Usage: pinder_bench_resumable [SIZE] [QUERIES]
+ */
+
+#include <algorithm>        /* std::max */
+#include <chrono>           /* std::chrono */
+#include <cstdio>           /* printf */
+#include <cstdlib>          /* atoi */
+
+#include "bench_maps.h"
+
+#include "search_algorithm.h"
+#include "BoardView.h"
+
+
+#define DEFAULT_SIZE        512
+#define DEFAULT_QUERIES     20
+
+// Time budget of a slice, in microseconds
+#define SLICE_US            500
+
+
+using graph::Location;
+
+typedef std::chrono::steady_clock Clock;
+typedef SearchWorkspace<Location, double> Workspace;
+typedef graph::BoardView<graph::EightWay> View;
+
+struct Totals {
+    long slices = 0;
+    double ms = 0;
+    double longest_ms = 0;
+};
+
+static double elapsed_ms(const Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(
+        Clock::now() - since
+    ).count();
+}
+
+// slice runs one slice of search and returns true once it is over
+template<typename Engine, typename Slice>
+Totals run(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace,
+    Slice slice
+)
+{
+    Totals totals;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+        bool over = false;
+
+        // Starting, which resets the workspace, counts with the first slice
+        Clock::time_point t0 = Clock::now();
+        ResumableSearch<Engine, View, Workspace> search(view, workspace);
+        double ms = elapsed_ms(t0);
+
+        while (!over) {
+            t0 = Clock::now();
+
+            over = slice(search);
+
+            ms += elapsed_ms(t0);
+
+            totals.ms += ms;
+            totals.longest_ms = std::max(totals.longest_ms, ms);
+            ++totals.slices;
+
+            ms = 0;
+        }
+    }
+
+    return totals;
+}
+
+template<typename Engine>
+Totals run_whole(
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace
+)
+{
+    Totals totals;
+    Engine engine;
+
+    for (const auto& query : queries) {
+        View view(board, query.first, query.second);
+
+        Clock::time_point t0 = Clock::now();
+
+        engine(view, workspace);
+
+        double ms = elapsed_ms(t0);
+
+        totals.ms += ms;
+        totals.longest_ms = std::max(totals.longest_ms, ms);
+        ++totals.slices;
+    }
+
+    return totals;
+}
+
+static void print(const char* name, const Totals& totals)
+{
+    printf("    %-16s %10ld %10.1f %12.3f\n", name,
+        totals.slices, totals.ms, totals.longest_ms);
+}
+
+template<typename Engine>
+void run_all(
+    const char* name,
+    const graph::Board& board,
+    const std::vector<std::pair<Location, Location>>& queries,
+    Workspace& workspace
+)
+{
+    printf("  %s\n", name);
+
+    print("whole", run_whole<Engine>(board, queries, workspace));
+
+    print("64 expansions", run<Engine>(board, queries, workspace,
+        [](auto& search) { return search.step(64); }));
+    print("1024 expansions", run<Engine>(board, queries, workspace,
+        [](auto& search) { return search.step(1024); }));
+    print("500 us", run<Engine>(board, queries, workspace,
+        [](auto& search) {
+            return search.runFor(std::chrono::microseconds(SLICE_US));
+        }));
+}
+
+int main(int argc, char* argv[])
+{
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int n_queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+    if (size < 2 * BENCH_ROOM_SIZE || n_queries < 1) {
+        fprintf(stderr, "Usage: %s [SIZE] [QUERIES]\n", argv[0]);
+        return 1;
+    }
+
+    graph::Board board(size, size);
+    Workspace workspace(size, size);
+
+    printf("%dx%d boards, %d queries, 8-way movement\n", size, size, n_queries);
+
+    for (BenchMap map : BENCH_MAPS) {
+        bench_fill_map(board, map);
+        auto queries = bench_queries(board, n_queries);
+
+        printf("\n%s\n    %-16s %10s %10s %12s\n", bench_map_name(map),
+            "", "slices", "ms", "longest ms");
+
+        run_all<AStarSearch<Octile>>("A*", board, queries, workspace);
+        run_all<DijkstraSearch>("Dijkstra", board, queries, workspace);
+        run_all<BreadthFirstSearch>("BFS", board, queries, workspace);
+    }
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BATCH_SEARCH_H
+#define BATCH_SEARCH_H  1
+
+#include <cstddef>          /* std::size_t          */
+#include <type_traits>      /* std::remove_const_t  */
+#include <utility>          /* std::pair            */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board     */
+#include "../graph/BoardView.h"     /* graph::BoardView */
+
+#include "Components.h"     /* Components           */
+#include "heuristics.h"     /* MatchedHeuristic     */
+#include "search_algorithm.h"
+#include "SearchStats.h"
+#include "WorkStealingPool.h"
+
+// A* with its own frontier, so each worker reuses one
+template<
+    typename Movement,
+    typename Heuristic = typename MatchedHeuristic<Movement>::type
+>
+struct BatchAStar {
+    Heuristic heuristic;
+    IndexedHeap<graph::Location, double> frontier;
+
+    template<typename Graph, typename Workspace>
+    void operator() (
+        const Graph& graph, Workspace& workspace, SearchStats& stats
+    )
+    {
+        AStarSearch<Heuristic>(HeuristicPriority<Heuristic>(heuristic))
+            .withSink(StatsSink(stats))(graph, workspace, frontier);
+    }
+};
+
+// Same for Jump Point Search. 8-way movement only
+template<typename Heuristic = Octile>
+struct BatchJps {
+    Heuristic heuristic;
+    IndexedHeap<graph::Location, double> frontier;
+
+    template<typename Graph, typename Workspace>
+    void operator() (
+        const Graph& graph, Workspace& workspace, SearchStats& stats
+    )
+    {
+        JumpPointSearch<Heuristic>(HeuristicPriority<Heuristic>(heuristic))
+            .withSink(StatsSink(stats))(graph, workspace, frontier);
+    }
+};
+
+// Dijkstra, same
+struct BatchDijkstra {
+    IndexedHeap<graph::Location, double> frontier;
+
+    template<typename Graph, typename Workspace>
+    void operator() (
+        const Graph& graph, Workspace& workspace, SearchStats& stats
+    )
+    {
+        DijkstraSearch().withSink(StatsSink(stats))(
+            graph, workspace, frontier
+        );
+    }
+};
+
+// Breadth first search, same
+struct BatchBfs {
+    FifoQueue<graph::Location, double> frontier;
+
+    template<typename Graph, typename Workspace>
+    void operator() (
+        const Graph& graph, Workspace& workspace, SearchStats& stats
+    )
+    {
+        BreadthFirstSearch().withSink(StatsSink(stats))(
+            graph, workspace, frontier
+        );
+    }
+};
+
+/*
+ * Answers many (start, goal) queries on one board at once, spread over a
+ * WorkStealingPool.
+ *
+ * Every worker has its own workspace and its own copy of search, frontier
+ * included, and they are kept between batches, so a search allocates
+ * nothing once the first batch is done. Each query gets a BoardView with its
+ * own start and goal, so the board itself is only read and must not change
+ * while run() is going.
+ *
+ * Queries whose start and goal are in different components are answered
+ * without searching. The components follow the board's edits between
+ * batches.
+ *
+ * search is called as search(view, workspace, stats), like BatchAStar, and
+ * fills in the result's SearchStats.
+ *
+ * Grid is graph::Board, or a const read-only board like graph::MappedBoard.
+ */
+template<
+    typename Movement,
+    typename Search = BatchAStar<Movement>,
+    typename Grid = graph::Board
+>
+class BatchSearch {
+public:
+    typedef graph::Location location_t;
+    typedef double cost_t;
+    typedef std::pair<location_t, location_t> query_t;
+
+    struct Result {
+        // start ~> goal, both included. Empty if there is no path
+        std::vector<location_t> path;
+        cost_t cost = 0;
+        bool found = false;
+        // All zeros if start or goal is a wall, or they are not connected
+        SearchStats stats;
+    };
+
+    // 0 threads means one per hardware thread
+    explicit BatchSearch(
+        Grid& board_, unsigned threads = 0, Search search = Search()
+    )
+    : board(board_), components(board_), pool(threads),
+      workers(pool.size(), Worker{Workspace(), search}) {}
+
+    unsigned countThreads() const
+    {
+        return pool.size();
+    }
+
+    // results[i] answers queries[i]
+    void run(
+        const std::vector<query_t>& queries, std::vector<Result>& results
+    )
+    {
+        results.resize(queries.size());
+
+        // Workers only read them
+        components.update();
+
+        pool.run(queries.size(), [&](unsigned worker, std::size_t i) {
+            answer(workers[worker], queries[i], results[i]);
+        });
+    }
+
+private:
+    typedef SearchWorkspace<location_t, cost_t> Workspace;
+    typedef graph::BoardView<Movement, std::remove_const_t<Grid>> View;
+
+    struct Worker {
+        Workspace workspace;
+        Search search;
+    };
+
+    const Grid& board;
+    Components<graph::EightWay, Grid> components;
+
+    WorkStealingPool pool;
+    std::vector<Worker> workers;
+
+    void answer(Worker& worker, const query_t& query, Result& result)
+    {
+        View view(board, query.first, query.second);
+
+        result.path.clear();
+        result.cost = 0;
+        result.found = false;
+        result.stats = SearchStats();
+
+        if (!components.sameComponent(query.first, query.second))
+            return;
+
+        worker.search(view, worker.workspace, result.stats);
+
+        result.found = search_reconstruct_path(
+            view, worker.workspace, result.path
+        );
+
+        if (result.found)
+            result.cost = worker.workspace.costSoFar(query.second);
+    }
+};
+
+#endif /* BATCH_SEARCH_H */
@@ -0,0 +1,362 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BEST_FIRST_SEARCH_H
+#define BEST_FIRST_SEARCH_H 1
+
+#include <cstddef>          /* std::size_t          */
+#include <limits>           /* std::numeric_limits  */
+
+#include "PriorityQueue.h"
+#include "SearchWorkspace.h"
+
+/*
+ * One best-first search loop for every algorithm that pops a frontier,
+ * closes what it pops and relaxes what comes after it. What changes between
+ * algorithms is a policy, picked at compile time:
+ *
+ * - Priority: key of a cell in the frontier, given its cost so far. The
+ *   heuristic, if there is one, lives here (see HeuristicPriority).
+ * - Frontier: queue used when none is passed in, any of PriorityQueue,
+ *   IndexedHeap, RadixHeap, BucketQueue or FifoQueue.
+ * - Successors: which cells come after one, and what getting there costs.
+ * - Closing: when a cell's cost is final and what a stale pop is.
+ * - Stop: whether to stop once a given cell is expanded. Cancellable (see
+ *   SearchControl.h) also stops when another thread asks it to.
+ * - Sink: told about every pop, expansion and push, e.g. StatsSink or
+ *   ProgressSink.
+ *
+ * Policies are small structs with inline members, most of them empty, so
+ * the compiler folds them into the loop and one that does nothing costs
+ * nothing. bfs.h, dijkstra.h, a_star.h and jps.h are aliases of this.
+ */
+
+// Dijkstra and BFS: the cost so far
+struct CostPriority {
+    template<typename CostType, typename Location>
+    inline CostType operator() (
+        const CostType cost, const Location&, const Location&
+    ) const
+    {
+        return cost;
+    }
+};
+
+// graph.neighbors(), charged graph.cost()
+struct AllNeighbors {
+    template<typename Graph, typename Workspace, typename Visit>
+    inline void expand(
+        const Graph& graph, const Workspace&,
+        const typename Graph::location_t current, Visit visit
+    ) const
+    {
+        for (typename Graph::location_t next: graph.neighbors(current))
+            visit(next);
+    }
+
+    template<typename Graph>
+    inline double cost(
+        const Graph& graph,
+        const typename Graph::location_t from,
+        const typename Graph::location_t to
+    ) const
+    {
+        return graph.cost(from, to);
+    }
+
+    // Called once the search is over
+    template<typename Graph, typename Workspace>
+    inline void finish(const Graph&, Workspace&) const {}
+};
+
+// Same neighbors, every step counted as one
+struct UnitNeighbors : AllNeighbors {
+    template<typename Graph>
+    inline double cost(
+        const Graph&,
+        const typename Graph::location_t,
+        const typename Graph::location_t
+    ) const
+    {
+        return 1;
+    }
+};
+
+/*
+ * Expanded cells are closed. Stale frontier entries left behind by queues
+ * without decrease-key are skipped, and closed cells are never reopened, so
+ * rounding noise cannot expand a cell twice. Heuristics must be consistent.
+ */
+struct CloseOnExpand {
+    template<typename Workspace, typename Location>
+    inline bool stale(const Workspace& workspace, const Location& current)
+        const
+    {
+        return workspace.closed(current);
+    }
+
+    template<typename Workspace, typename Location>
+    inline void close(Workspace& workspace, const Location& current) const
+    {
+        workspace.close(current);
+    }
+
+    template<typename Workspace, typename Location>
+    inline bool skip(const Workspace& workspace, const Location& next) const
+    {
+        return workspace.closed(next);
+    }
+
+    template<typename Workspace, typename Location, typename CostType>
+    inline bool improves(
+        const Workspace& workspace, const Location& next,
+        const CostType new_cost
+    ) const
+    {
+        return !workspace.visited(next)
+            || new_cost < workspace.costSoFar(next);
+    }
+};
+
+// BFS: a cell's first visit is already its cheapest, so there is nothing
+// to close and nothing goes stale
+struct FirstVisitFinal {
+    template<typename Workspace, typename Location>
+    inline bool stale(const Workspace&, const Location&) const
+    {
+        return false;
+    }
+
+    template<typename Workspace, typename Location>
+    inline void close(Workspace&, const Location&) const {}
+
+    template<typename Workspace, typename Location>
+    inline bool skip(const Workspace& workspace, const Location& next) const
+    {
+        return workspace.visited(next);
+    }
+
+    template<typename Workspace, typename Location, typename CostType>
+    inline bool improves(const Workspace&, const Location&, const CostType)
+        const
+    {
+        return true;
+    }
+};
+
+// Early exit once the goal is expanded
+struct StopAtGoal {
+    template<typename Location>
+    inline bool operator() (const Location& current, const Location& goal)
+        const
+    {
+        return current == goal;
+    }
+};
+
+// Expands everything reachable, whatever the goal is
+struct StopNever {
+    template<typename Location>
+    inline bool operator() (const Location&, const Location&) const
+    {
+        return false;
+    }
+};
+
+// Ignores every event
+struct NullSink {
+    inline void started() {}
+
+    template<typename Location>
+    inline void popped(const Location&) {}
+
+    template<typename Location>
+    inline void stale(const Location&) {}
+
+    template<typename Location>
+    inline void expanded(const Location&) {}
+
+    template<typename Location, typename Frontier>
+    inline void pushed(const Location&, const Frontier&) {}
+
+    template<typename Workspace, typename Frontier>
+    inline void finished(const Workspace&, const Frontier&) {}
+};
+
+template<
+    typename Priority,
+    template<typename, typename> class Frontier = PriorityQueue,
+    typename Successors = AllNeighbors,
+    typename Closing = CloseOnExpand,
+    typename Stop = StopAtGoal,
+    typename Sink = NullSink
+>
+struct BestFirstSearch {
+    // Same engine, other sink or stop rule
+    template<typename OtherSink>
+    using WithSink = BestFirstSearch<
+        Priority, Frontier, Successors, Closing, Stop, OtherSink
+    >;
+
+    template<typename OtherStop>
+    using WithStop = BestFirstSearch<
+        Priority, Frontier, Successors, Closing, OtherStop, Sink
+    >;
+
+    Priority priority;
+    Successors successors;
+    Closing closing;
+    Stop stop;
+    Sink sink;
+
+    explicit BestFirstSearch(
+        Priority priority_ = Priority(), Sink sink_ = Sink(),
+        Stop stop_ = Stop(), Successors successors_ = Successors()
+    )
+    : priority(priority_), successors(successors_), closing(),
+      stop(stop_), sink(sink_) {}
+
+    // A copy reporting to other_sink instead
+    template<typename OtherSink>
+    WithSink<OtherSink> withSink(OtherSink other_sink) const
+    {
+        return WithSink<OtherSink>(priority, other_sink, stop, successors);
+    }
+
+    template<typename OtherStop>
+    WithStop<OtherStop> withStop(OtherStop other_stop) const
+    {
+        return WithStop<OtherStop>(priority, sink, other_stop, successors);
+    }
+
+    // Frontier used when none is passed in
+    template<typename Location, typename CostType>
+    using FrontierType = Frontier<Location, CostType>;
+
+    /*
+     * Leaves came_from and cost so far in workspace. Passing frontier in
+     * lets it be reused between searches. Its keys and tie values (the
+     * cost so far, larger first) have workspace's cost type.
+     */
+    template<typename Graph, typename Workspace, typename Queue>
+    void operator() (
+        const Graph& graph,
+        Workspace& workspace,
+        Queue& frontier
+    )
+    {
+        std::size_t budget = std::numeric_limits<std::size_t>::max();
+
+        start(graph, workspace, frontier);
+        resume(graph, workspace, frontier, budget);
+    }
+
+    /*
+     * The same search in pieces (see ResumableSearch.h): start() queues the
+     * start cell, then every resume() expands until budget, counted down,
+     * runs out. resume() returns true once the search is over, and must not
+     * be called again after that.
+     */
+    template<typename Graph, typename Workspace, typename Queue>
+    void start(const Graph& graph, Workspace& workspace, Queue& frontier)
+    {
+        const typename Graph::location_t& start = graph.getStart();
+
+        sink.started();
+
+        frontier.reset(graph.getRows(), graph.getColumns());
+        frontier.put(start, 0);
+        sink.pushed(start, frontier);
+
+        workspace.resize(graph.getRows(), graph.getColumns());
+        workspace.reset();
+        workspace.visit(start, start, 0);
+    }
+
+    template<typename Graph, typename Workspace, typename Queue>
+    bool resume(
+        const Graph& graph,
+        Workspace& workspace,
+        Queue& frontier,
+        std::size_t& budget
+    )
+    {
+        typedef typename Graph::location_t Location;
+        typedef typename Workspace::cost_t CostType;
+
+        const Location& goal = graph.getGoal();
+        Location current = {};
+        bool over = false;
+
+        auto relax = [&](const Location next) {
+            if (closing.skip(workspace, next))
+                return;
+
+            CostType new_cost = workspace.costSoFar(current)
+                + successors.cost(graph, current, next);
+
+            if (closing.improves(workspace, next, new_cost)) {
+                workspace.visit(next, current, new_cost);
+
+                frontier.put(next, priority(new_cost, next, goal), new_cost);
+                sink.pushed(next, frontier);
+            }
+        };
+
+        while (budget > 0 && !frontier.empty()) {
+            current = frontier.get();
+            sink.popped(current);
+
+            if (closing.stale(workspace, current)) {
+                sink.stale(current);
+                continue;
+            }
+
+            closing.close(workspace, current);
+            sink.expanded(current);
+            --budget;
+
+            if (stop(current, goal)) {
+                over = true;
+                break;
+            }
+
+            successors.expand(graph, workspace, current, relax);
+        }
+
+        if (!over && !frontier.empty())
+            return false;
+
+        successors.finish(graph, workspace);
+        sink.finished(workspace, frontier);
+
+        return true;
+    }
+
+    // Same, with a fresh Frontier
+    template<typename Graph, typename Workspace>
+    void operator() (const Graph& graph, Workspace& workspace)
+    {
+        Frontier<typename Graph::location_t, typename Workspace::cost_t>
+            frontier;
+
+        (*this)(graph, workspace, frontier);
+    }
+};
+
+#endif /* BEST_FIRST_SEARCH_H */
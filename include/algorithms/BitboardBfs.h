@@ -0,0 +1,425 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BITBOARD_BFS_H
+#define BITBOARD_BFS_H  1
+
+#include <algorithm>        /* std::min, std::max, std::fill */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint32_t, std::uint64_t */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Location.h"      /* graph::Location */
+
+/*
+ * Breadth first search on bitboards, for step counts and reachability on
+ * large boards. Free cells, the cells reached so far and the frontier are
+ * one bit per cell, 64 cells per word, so a whole layer grows with shifts,
+ * ANDs and ORs of the words around it instead of one queue entry at a time.
+ * Only the words next to a frontier word are grown, so a layer costs what
+ * its frontier covers, not the board's size.
+ *
+ * Nothing is written per cell. Neighbors are at most one layer apart, so
+ * two more bit planes holding each cell's layer modulo 3 are enough for
+ * cameFrom() to find a neighbor one layer closer afterwards: what
+ * breadth_first_search's came_from would hold, up to ties. Distances are
+ * counted back along those parents. Like breadth_first_search, weights
+ * count as one step.
+ *
+ * The free cells are copied in load(), so edit the board, load() again.
+ */
+template<typename Movement>
+class BitboardBfs {
+public:
+    typedef graph::Location location_t;
+    typedef std::uint32_t distance_t;
+
+    static constexpr distance_t unreached
+        = std::numeric_limits<distance_t>::max();
+
+    BitboardBfs() : rows(0), columns(0), words(0), origin{-1, -1},
+        n_reached(0) {}
+
+    template<typename Grid>
+    explicit BitboardBfs(const Grid& grid) : BitboardBfs()
+    {
+        load(grid);
+    }
+
+    // Copies which cells of grid are free
+    template<typename Grid>
+    void load(const Grid& grid)
+    {
+        rows = grid.getRows();
+        columns = grid.getColumns();
+        words = ((std::size_t) columns + 63) / 64;
+
+        // A row of zeros above and below, so the first and last rows need
+        // no special case
+        std::size_t n_words = (rows + 2) * words;
+
+        free_cells.assign(n_words, 0);
+        seen.assign(n_words, 0);
+        current.assign(n_words, 0);
+        next.assign(n_words, 0);
+
+        phase_low.assign(n_words, 0);
+        phase_high.assign(n_words, 0);
+        checked.assign(n_words, 0);
+        current_words.clear();
+        next_words.clear();
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                if (grid.passable({x, y}))
+                    row(free_cells, y)[x >> 6] |= bit(x);
+            }
+        }
+    }
+
+    /*
+     * Floods from start, layer by layer, until goal is reached or there is
+     * nothing left to reach. A goal outside the board floods everything.
+     * Returns whether goal was reached.
+     */
+    bool search(const location_t start, const location_t goal = {-1, -1})
+    {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(checked.begin(), checked.end(), 0);
+        std::fill(phase_low.begin(), phase_low.end(), 0);
+        std::fill(phase_high.begin(), phase_high.end(), 0);
+        n_reached = 0;
+        origin = start;
+
+        if (!isFree(start))
+            return false;
+
+        std::size_t first = wordIndex(start.y, start.x >> 6);
+
+        seen[first] = bit(start.x);
+        current[first] = bit(start.x);
+        current_words.assign(1, first);
+
+        n_reached = 1;
+
+        distance_t layer = 0;
+
+        while (!current_words.empty() && !reached(goal)) {
+            ++layer;
+
+            for (std::size_t i : current_words)
+                grow(i, layer);
+
+            // Leave current all zeros again, and swap
+            for (std::size_t i : current_words)
+                current[i] = 0;
+
+            current.swap(next);
+            current_words.swap(next_words);
+            next_words.clear();
+        }
+
+        // Stopped at the goal: clear what is left of the frontier
+        for (std::size_t i : current_words)
+            current[i] = 0;
+
+        current_words.clear();
+
+        return reached(goal);
+    }
+
+    inline bool reached(const location_t position) const
+    {
+        return inBounds(position)
+            && (row(seen, position.y)[position.x >> 6] & bit(position.x));
+    }
+
+    // Steps from the last search's start, unreached if it was not reached.
+    // Walks back to the start, so it takes as long as that
+    distance_t distance(location_t position) const
+    {
+        if (!reached(position))
+            return unreached;
+
+        distance_t steps = 0;
+
+        for (; position != origin; ++steps)
+            position = cameFrom(position);
+
+        return steps;
+    }
+
+    // Cells the last search reached, its start included
+    std::size_t countReached() const
+    {
+        return n_reached;
+    }
+
+    // A neighbor one step closer to the start. The start is its own
+    inline location_t cameFrom(const location_t position) const
+    {
+        if (position == origin || !reached(position))
+            return position;
+
+        int closer = (phase(position) + 2) % 3;
+
+        for (const location_t& direction : Movement::DIRS) {
+            location_t from = {
+                position.x + direction.x, position.y + direction.y
+            };
+
+            if (reached(from) && phase(from) == closer
+                && canStep(from, position))
+            {
+                return from;
+            }
+        }
+
+        return position;
+    }
+
+    // start ~> to, both included. False (and empty) if to was not reached
+    bool path(const location_t to, std::vector<location_t>& cells) const
+    {
+        cells.clear();
+
+        if (!reached(to))
+            return false;
+
+        location_t current_cell = to;
+        cells.push_back(current_cell);
+
+        while (current_cell != origin) {
+            current_cell = cameFrom(current_cell);
+            cells.push_back(current_cell);
+        }
+
+        std::reverse(cells.begin(), cells.end());
+
+        return true;
+    }
+
+    // Leaves the result in a workspace as breadth_first_search would
+    template<typename Workspace>
+    void exportTo(Workspace& workspace) const
+    {
+        std::vector<location_t> chain;
+
+        workspace.resize(rows, columns);
+        workspace.reset();
+
+        if (!reached(origin))
+            return;
+
+        workspace.visit(origin, origin, 0);
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                // Back to a cell that already has its distance, then down
+                for (location_t cell = {x, y};
+                    reached(cell) && !workspace.visited(cell);
+                    cell = cameFrom(cell))
+                {
+                    chain.push_back(cell);
+                }
+
+                for (; !chain.empty(); chain.pop_back()) {
+                    location_t from = cameFrom(chain.back());
+
+                    workspace.visit(chain.back(), from,
+                        workspace.costSoFar(from) + 1);
+                }
+            }
+        }
+    }
+
+private:
+    typedef std::uint64_t word_t;
+
+    int rows, columns;
+    std::size_t words;
+
+    // Start of the last search
+    location_t origin;
+    std::size_t n_reached;
+
+    // rows + 2 rows of words each
+    std::vector<word_t> free_cells;
+    std::vector<word_t> seen;
+    std::vector<word_t> current;
+    std::vector<word_t> next;
+    // Layer of each reached cell, modulo 3
+    std::vector<word_t> phase_low;
+    std::vector<word_t> phase_high;
+
+    // Last layer each word was grown in, so it is grown only once
+    std::vector<distance_t> checked;
+
+    // Words of current and next that have bits
+    std::vector<std::size_t> current_words;
+    std::vector<std::size_t> next_words;
+
+    static inline word_t bit(const int x)
+    {
+        return (word_t) 1 << (x & 63);
+    }
+
+    inline word_t* row(std::vector<word_t>& plane, const int y)
+    {
+        return &plane[(y + 1) * words];
+    }
+
+    inline const word_t* row(const std::vector<word_t>& plane, const int y)
+        const
+    {
+        return &plane[(y + 1) * words];
+    }
+
+    inline std::size_t wordIndex(const int y, const int w) const
+    {
+        return (y + 1) * words + w;
+    }
+
+    // Layer of a reached cell, modulo 3
+    inline int phase(const location_t position) const
+    {
+        std::size_t i = wordIndex(position.y, position.x >> 6);
+        word_t mask = bit(position.x);
+
+        return ((phase_low[i] & mask) ? 1 : 0)
+            | ((phase_high[i] & mask) ? 2 : 0);
+    }
+
+    inline bool inBounds(const location_t position) const
+    {
+        return position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows;
+    }
+
+    inline bool isFree(const location_t position) const
+    {
+        return inBounds(position)
+            && (row(free_cells, position.y)[position.x >> 6]
+                & bit(position.x));
+    }
+
+    // Whether one move goes from a to its neighbor b
+    inline bool canStep(const location_t a, const location_t b) const
+    {
+        if (!isFree(a) || !isFree(b))
+            return false;
+
+        if constexpr (Movement::diagonals && !Movement::corner_cutting) {
+            if (a.x != b.x && a.y != b.y)
+                return isFree({b.x, a.y}) && isFree({a.x, b.y});
+        }
+
+        return true;
+    }
+
+    // Word w of a row moved one cell east (bit x to x + 1) or west
+    inline word_t east(const word_t* r, const int w) const
+    {
+        return (r[w] << 1) | (w > 0 ? r[w - 1] >> 63 : 0);
+    }
+
+    inline word_t west(const word_t* r, const int w) const
+    {
+        return (r[w] >> 1) | (w + 1 < (int) words ? r[w + 1] << 63 : 0);
+    }
+
+    // Cells of word w in row y one step away from the frontier
+    inline word_t step(const int y, const int w) const
+    {
+        const word_t* above = row(current, y - 1);
+        const word_t* here = row(current, y);
+        const word_t* below = row(current, y + 1);
+
+        word_t grown = east(here, w) | west(here, w) | above[w] | below[w];
+
+        if constexpr (Movement::diagonals && Movement::corner_cutting) {
+            grown |= east(above, w) | west(above, w)
+                | east(below, w) | west(below, w);
+        }
+        else if constexpr (Movement::diagonals) {
+            // Diagonal steps need both cells they squeeze between free
+            const word_t* free_above = row(free_cells, y - 1);
+            const word_t* free_here = row(free_cells, y);
+            const word_t* free_below = row(free_cells, y + 1);
+
+            word_t east_free = east(free_here, w);
+            word_t west_free = west(free_here, w);
+
+            grown |= east(above, w) & free_above[w] & east_free;
+            grown |= west(above, w) & free_above[w] & west_free;
+            grown |= east(below, w) & free_below[w] & east_free;
+            grown |= west(below, w) & free_below[w] & west_free;
+        }
+
+        return grown & row(free_cells, y)[w] & ~row(seen, y)[w];
+    }
+
+    /*
+     * Grows word i of the frontier into next. Its bits can only reach the
+     * words above, below and itself, and the ones to the sides if a bit
+     * sits on that edge of the word.
+     */
+    void grow(const std::size_t i, const distance_t layer)
+    {
+        int y = (int) (i / words) - 1;
+        int w = (int) (i % words);
+        word_t bits = current[i];
+
+        int first = (w > 0 && (bits & 1)) ? w - 1 : w;
+        int last = (w + 1 < (int) words && (bits >> 63)) ? w + 1 : w;
+
+        for (int r = std::max(y - 1, 0); r <= std::min(y + 1, rows - 1); ++r) {
+            for (int c = first; c <= last; ++c)
+                growWord(r, c, layer);
+        }
+    }
+
+    inline void growWord(const int y, const int w, const distance_t layer)
+    {
+        std::size_t i = wordIndex(y, w);
+
+        if (checked[i] == layer)
+            return;
+
+        checked[i] = layer;
+
+        word_t found = step(y, w);
+
+        if (!found)
+            return;
+
+        next[i] = found;
+        seen[i] |= found;
+        next_words.push_back(i);
+
+        if (layer % 3 == 1)
+            phase_low[i] |= found;
+        else if (layer % 3 == 2)
+            phase_high[i] |= found;
+
+        n_reached += __builtin_popcountll(found);
+    }
+};
+
+#endif /* BITBOARD_BFS_H */
@@ -0,0 +1,143 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H   1
+
+#include <cmath>            /* std::floor           */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint64_t        */
+#include <cstdio>           /* fprintf              */
+#include <cstdlib>          /* std::abort           */
+#include <type_traits>      /* std::is_floating_point */
+#include <vector>           /* std::vector          */
+
+/*
+ * Monotone bucket queue (Dial's algorithm), a drop-in replacement for
+ * PriorityQueue when priorities are small integers, e.g. Dijkstra or A* with
+ * Manhattan distance on a 4-way board where every cost is 1 or 5.
+ *
+ * There is one bucket per priority value, in a ring that only has to span
+ * the distance between the smallest and the largest pending priority. The
+ * ring doubles when a priority does not fit. put() and get() are O(1)
+ * amortized.
+ *
+ * Priorities must be whole numbers and never lower than the last one taken
+ * out (lower ones are raised to it). Items with the same priority come out
+ * last in, first out; the tie argument is accepted only for interface
+ * compatibility.
+ *
+ * So it only suits integer costs: 4-way movement, Manhattan distance. A
+ * fractional priority, e.g. a sqrt(2) diagonal step, would land in the wrong
+ * bucket and make paths silently longer than optimal, so put() aborts on one
+ * in every build.
+ */
+template<typename T, typename priority_t>
+class BucketQueue {
+public:
+    typedef std::uint64_t key_t;
+
+    BucketQueue() : base(0), count(0), buckets(64) {}
+
+    inline bool empty() const {
+        return count == 0;
+    }
+
+    inline std::size_t size() const {
+        return count;
+    }
+
+    std::size_t memoryUsage() const {
+        std::size_t bytes = buckets.capacity() * sizeof(std::vector<T>);
+
+        for (const std::vector<T>& bucket : buckets)
+            bytes += bucket.capacity() * sizeof(T);
+
+        return bytes;
+    }
+
+    // Empties the queue. The grid size is only used by IndexedHeap
+    void reset(int rows, int columns) {
+        for (std::vector<T>& bucket : buckets)
+            bucket.clear();
+
+        base = 0;
+        count = 0;
+    }
+
+    inline void put(T item, priority_t priority, priority_t tie = priority_t()) {
+        if constexpr (std::is_floating_point<priority_t>::value) {
+            if (std::floor(priority) != priority) {
+                fprintf(stderr, "BucketQueue: priority %g is not a whole"
+                    " number\n", (double) priority);
+                std::abort();
+            }
+        }
+
+        key_t key = priority > 0 ? (key_t) priority : 0;
+
+        if (key < base)
+            key = base;
+
+        if (key - base >= buckets.size())
+            grow(key - base + 1);
+
+        buckets[key & (buckets.size() - 1)].push_back(item);
+        ++count;
+    }
+
+    T get() {
+        std::size_t mask = buckets.size() - 1;
+
+        while (buckets[base & mask].empty())
+            ++base;
+
+        std::vector<T>& bucket = buckets[base & mask];
+
+        T best_item = bucket.back();
+        bucket.pop_back();
+        --count;
+
+        return best_item;
+    }
+
+private:
+    key_t base;             // Smallest priority that may still be queued
+    std::size_t count;
+
+    std::vector<std::vector<T>> buckets;    // Size is a power of two
+
+    void grow(const key_t span) {
+        std::size_t old_size = buckets.size(), new_size = old_size;
+
+        while (new_size < span)
+            new_size *= 2;
+
+        std::vector<std::vector<T>> old_buckets(new_size);
+        old_buckets.swap(buckets);
+
+        // Bucket i held the key in [base, base + old_size) congruent to it
+        for (std::size_t i = 0; i < old_size; ++i) {
+            key_t key = base + ((i - base) & (old_size - 1));
+
+            buckets[key & (new_size - 1)].swap(old_buckets[i]);
+        }
+    }
+};
+
+#endif /* BUCKETQUEUE_H */
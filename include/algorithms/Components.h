@@ -0,0 +1,401 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef COMPONENTS_H
+#define COMPONENTS_H    1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint8_t, std::uint32_t */
+#include <cstdlib>          /* std::abs             */
+#include <type_traits>      /* std::is_const        */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board, graph::BoardListener */
+#include "../graph/Movement.h"      /* graph::Neighbors */
+
+/*
+ * Connected components of a board's free cells under a movement policy, so
+ * a query whose start and goal can never meet is rejected before a search
+ * floods everything it can reach.
+ *
+ * Every free cell has a label and labels are joined with union-find, so a
+ * removed wall only merges the components around it. A new wall can split a
+ * component, but usually does not: if the free cells around it are still
+ * joined inside its 3x3 neighborhood, nothing changes. Otherwise a search
+ * grows from each of those cells in turn, until all but one of them have
+ * either met another or run out of cells. The ones that ran out get new
+ * labels, so the cost is that of the smaller pieces, not of the board.
+ *
+ * Clearing the board relabels everything, on the next query.
+ *
+ * All policies only ever join cells that graph::EightWay joins too, so its
+ * components can reject queries for any of them.
+ *
+ * Grid can also be a const board, e.g. a graph::MappedBoard, which never
+ * changes and so is not listened to.
+ */
+template<typename Movement, typename Grid = graph::Board>
+class Components final : public graph::BoardListener {
+public:
+    typedef graph::Location location_t;
+
+    explicit Components(Grid& board_)
+    : board(board_)
+    {
+        if constexpr (!std::is_const<Grid>::value)
+            board.addListener(this);
+
+        relabel();
+    }
+
+    ~Components()
+    {
+        if constexpr (!std::is_const<Grid>::value)
+            board.removeListener(this);
+    }
+
+    Components(const Components&) = delete;
+    Components& operator= (const Components&) = delete;
+
+    // Whether a path from a to b can exist
+    bool connected(const location_t a, const location_t b)
+    {
+        if (!board.passable(a) || !board.passable(b))
+            return false;
+
+        return component(a) == component(b);
+    }
+
+    /*
+     * Same as connected(), but nothing is relabelled or compressed, so many
+     * threads can ask at once while the board does not change. Labels must
+     * be up to date, see update().
+     */
+    bool sameComponent(const location_t a, const location_t b) const
+    {
+        if (!board.passable(a) || !board.passable(b))
+            return false;
+
+        return root(labels[cellIndex(a)]) == root(labels[cellIndex(b)]);
+    }
+
+    // Relabels now if an edit asked for it, instead of on the next query
+    void update()
+    {
+        if (dirty)
+            relabel();
+    }
+
+    // Component of position, -1 for walls. Ids change after edits
+    int component(const location_t position)
+    {
+        if (dirty)
+            relabel();
+
+        int label = labels[cellIndex(position)];
+
+        return (label < 0) ? label : find(label);
+    }
+
+    // Labels every cell from scratch
+    void relabel()
+    {
+        rows = board.getRows();
+        columns = board.getColumns();
+
+        labels.assign((std::size_t) rows * columns, -1);
+        parent.clear();
+
+        marks.assign(labels.size(), 0);
+        groups.assign(labels.size(), 0);
+        epoch = 0;
+
+        std::vector<location_t> pending;
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                if (labels[cellIndex({x, y})] >= 0 || !board.passable({x, y}))
+                    continue;
+
+                int label = (int) parent.size();
+                parent.push_back(label);
+
+                labels[cellIndex({x, y})] = label;
+                pending.push_back({x, y});
+
+                while (!pending.empty()) {
+                    location_t current = pending.back();
+                    pending.pop_back();
+
+                    for (location_t next :
+                        board.template neighbors<Movement>(current))
+                    {
+                        if (labels[cellIndex(next)] < 0) {
+                            labels[cellIndex(next)] = label;
+                            pending.push_back(next);
+                        }
+                    }
+                }
+            }
+        }
+
+        dirty = false;
+        ++relabels;
+    }
+
+    // How many times relabel() ran, the first one included
+    std::size_t countRelabels() const
+    {
+        return relabels;
+    }
+
+    void cellChanged(const location_t position) override
+    {
+        // Already waiting for a relabel, which may be for a new size too
+        if (dirty)
+            return;
+
+        std::size_t i = cellIndex(position);
+        bool was_free = labels[i] >= 0;
+
+        // Only a weight changed
+        if (board.passable(position) == was_free)
+            return;
+
+        if (!was_free) {
+            int label = (int) parent.size();
+            parent.push_back(label);
+            labels[i] = label;
+
+            for (location_t next :
+                board.template neighbors<Movement>(position))
+            {
+                unite(label, labels[cellIndex(next)]);
+            }
+
+            return;
+        }
+
+        labels[i] = -1;
+
+        if (!joinedAround(position))
+            split(position);
+    }
+
+    void boardCleared() override
+    {
+        dirty = true;
+    }
+
+private:
+    Grid& board;
+
+    int rows = 0, columns = 0;
+
+    // Per cell, -1 for walls
+    std::vector<int> labels;
+    // Union-find over labels
+    std::vector<int> parent;
+
+    bool dirty = false;
+    std::size_t relabels = 0;
+
+    // Scratch for split(): a cell was reached in this epoch, and by which
+    // of the searches
+    std::vector<std::uint32_t> marks;
+    std::vector<std::uint8_t> groups;
+    std::uint32_t epoch = 0;
+
+    inline std::size_t cellIndex(const location_t position) const
+    {
+        return (std::size_t) position.y * columns + position.x;
+    }
+
+    int find(int label)
+    {
+        while (parent[label] != label) {
+            parent[label] = parent[parent[label]];
+            label = parent[label];
+        }
+
+        return label;
+    }
+
+    // find() without path compression
+    int root(int label) const
+    {
+        while (parent[label] != label)
+            label = parent[label];
+
+        return label;
+    }
+
+    void unite(const int a, const int b)
+    {
+        parent[find(a)] = find(b);
+    }
+
+    /*
+     * Whether the cells that were next to a new wall can still reach each
+     * other without leaving its 3x3 neighborhood. Without corner cutting
+     * the wall also blocks diagonal steps between those same cells, which
+     * this covers too.
+     */
+    bool joinedAround(const location_t wall)
+    {
+        graph::Neighbors around = board.template neighbors<Movement>(wall);
+
+        if (around.size() < 2)
+            return true;
+
+        location_t reached[9];
+        std::size_t n_reached = 0, done = 0;
+
+        auto seen = [&](const location_t position) {
+            for (std::size_t k = 0; k < n_reached; ++k) {
+                if (reached[k] == position)
+                    return true;
+            }
+
+            return false;
+        };
+
+        reached[n_reached++] = around[0];
+
+        while (done < n_reached) {
+            location_t current = reached[done++];
+
+            for (location_t next : board.template neighbors<Movement>(current))
+            {
+                if (std::abs(next.x - wall.x) <= 1
+                    && std::abs(next.y - wall.y) <= 1 && !seen(next))
+                {
+                    reached[n_reached++] = next;
+                }
+            }
+        }
+
+        for (location_t each : around) {
+            if (!seen(each))
+                return false;
+        }
+
+        return true;
+    }
+
+    // One search from each cell next to a new wall, taking turns
+    void split(const location_t wall)
+    {
+        graph::Neighbors around = board.template neighbors<Movement>(wall);
+        std::size_t n = around.size();
+
+        // Searches that met share a root
+        int root[graph::Neighbors::max_dirs];
+        bool relabeled[graph::Neighbors::max_dirs];
+        std::vector<location_t> reached[graph::Neighbors::max_dirs];
+        std::size_t done[graph::Neighbors::max_dirs];
+
+        auto find_root = [&](int group) {
+            while (root[group] != group)
+                group = root[group];
+
+            return group;
+        };
+
+        if (++epoch == 0) {
+            marks.assign(marks.size(), 0);
+            epoch = 1;
+        }
+
+        for (std::size_t g = 0; g < n; ++g) {
+            root[g] = (int) g;
+            relabeled[g] = false;
+            done[g] = 0;
+
+            reached[g].push_back(around[g]);
+            mark(around[g], g);
+        }
+
+        // Roots still growing that no other search has met
+        std::size_t alive = n;
+
+        while (alive > 1) {
+            for (std::size_t g = 0; g < n; ++g) {
+                if (done[g] == reached[g].size())
+                    continue;
+
+                location_t current = reached[g][done[g]++];
+
+                for (location_t next :
+                    board.template neighbors<Movement>(current))
+                {
+                    std::size_t k = cellIndex(next);
+
+                    if (marks[k] != epoch) {
+                        reached[g].push_back(next);
+                        mark(next, g);
+                    }
+                    else if (find_root(groups[k]) != find_root(g)) {
+                        root[find_root(groups[k])] = find_root(g);
+                        --alive;
+                    }
+                }
+            }
+
+            // A root whose searches all ran out is a component of its own
+            for (std::size_t g = 0; g < n && alive > 1; ++g) {
+                int r = find_root(g);
+
+                if (r != (int) g || relabeled[r])
+                    continue;
+
+                bool finished = true;
+
+                for (std::size_t h = 0; h < n; ++h) {
+                    if (find_root(h) == r && done[h] < reached[h].size())
+                        finished = false;
+                }
+
+                if (!finished)
+                    continue;
+
+                int label = (int) parent.size();
+                parent.push_back(label);
+
+                for (std::size_t h = 0; h < n; ++h) {
+                    if (find_root(h) != r)
+                        continue;
+
+                    for (location_t each : reached[h])
+                        labels[cellIndex(each)] = label;
+                }
+
+                relabeled[r] = true;
+                --alive;
+            }
+        }
+    }
+
+    inline void mark(const location_t position, const std::size_t group)
+    {
+        marks[cellIndex(position)] = epoch;
+        groups[cellIndex(position)] = (std::uint8_t) group;
+    }
+};
+
+#endif /* COMPONENTS_H */
@@ -0,0 +1,373 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H    1
+
+#include <algorithm>        /* std::min             */
+#include <cstddef>          /* std::size_t          */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board, graph::BoardListener */
+
+#include "heuristics.h"     /* MatchedHeuristic     */
+#include "IndexedHeap.h"
+#include "SearchControl.h"
+
+/*
+ * D* Lite (Koenig and Likhachev, 2002): a search from the goal that is kept
+ * between queries, so after an edit only the cells whose cost to the goal
+ * changed are searched again.
+ *
+ * Every cell has g, its cost to the goal as last computed, and rhs, the best
+ * cost through its neighbors' g. Cells where the two differ are queued by
+ * key [min(g, rhs) + h(start, cell) + km, min(g, rhs)]. An edit only changes
+ * the edges of the 3x3 cells around it, so only their rhs are recomputed;
+ * the queue then spreads the change as far as it matters for start. km keeps
+ * old keys valid when start moves.
+ *
+ * The planner listens to the board and applies edits on the next plan().
+ * Heuristic must be consistent, see heuristics.h.
+ */
+template<
+    typename Movement,
+    typename Heuristic = typename MatchedHeuristic<Movement>::type
+>
+class DStarLite final : public graph::BoardListener {
+public:
+    typedef graph::Location location_t;
+    typedef double cost_t;
+
+    static constexpr cost_t infinity = std::numeric_limits<cost_t>::infinity();
+
+    explicit DStarLite(graph::Board& board_, Heuristic heuristic_ = Heuristic())
+    : board(board_), heuristic(heuristic_)
+    {
+        board.addListener(this);
+    }
+
+    ~DStarLite()
+    {
+        board.removeListener(this);
+    }
+
+    DStarLite(const DStarLite&) = delete;
+    DStarLite& operator= (const DStarLite&) = delete;
+
+    /*
+     * Brings the plan up to date for start ~> goal and tells whether there
+     * is a path. The first call, a new goal or a cleared board start over;
+     * otherwise only the edits since the last call are repaired.
+     *
+     * control, if given, hears about every expansion and can cancel. A
+     * cancelled plan() returns false, and the next one carries on from
+     * where it stopped.
+     */
+    bool plan(
+        const location_t start_, const location_t goal_,
+        SearchControl* control = nullptr
+    )
+    {
+        if (!started || goal_ != goal) {
+            initialize(start_, goal_);
+        }
+        else {
+            if (start_ != start) {
+                km += heuristic(start, start_);
+                start = start_;
+            }
+
+            for (const location_t& position : changed) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        location_t cell = {position.x + dx, position.y + dy};
+
+                        if (board.in_bounds(cell)) {
+                            rhs[index(cell)] = lookahead(cell);
+                            updateVertex(cell);
+                        }
+                    }
+                }
+            }
+        }
+
+        changed.clear();
+        expanded = 0;
+
+        if (!computeShortestPath(control))
+            return false;
+
+        return g[index(start)] != infinity;
+    }
+
+    // Cost from position to the goal as of the last plan()
+    inline cost_t costToGoal(const location_t position) const
+    {
+        return g[index(position)];
+    }
+
+    // Cells plan() took out of the queue
+    std::size_t countExpanded() const
+    {
+        return expanded;
+    }
+
+    // start ~> goal, both included, taking the cheapest step every time.
+    // Empty if there is no path
+    bool path(std::vector<location_t>& cells) const
+    {
+        cells.clear();
+
+        if (!started || g[index(start)] == infinity)
+            return false;
+
+        location_t current = start;
+        cells.push_back(current);
+
+        while (current != goal) {
+            location_t best = current;
+            cost_t best_cost = infinity;
+
+            for (location_t next : board.template neighbors<Movement>(current))
+            {
+                cost_t through = board.cost(current, next) + g[index(next)];
+
+                if (through < best_cost) {
+                    best_cost = through;
+                    best = next;
+                }
+            }
+
+            // Only if plan() was not called after the last edit
+            if (best == current || cells.size() > g.size()) {
+                cells.clear();
+                return false;
+            }
+
+            current = best;
+            cells.push_back(current);
+        }
+
+        return true;
+    }
+
+    // Leaves the path in workspace as a forward search would, ready for
+    // search_reconstruct_path()
+    template<typename Workspace>
+    void exportPath(Workspace& workspace) const
+    {
+        std::vector<location_t> cells;
+        cost_t cost = 0;
+
+        workspace.resize(board.getRows(), board.getColumns());
+        workspace.reset();
+        workspace.visit(start, start, 0);
+
+        path(cells);
+
+        for (std::size_t i = 1; i < cells.size(); ++i) {
+            cost += board.cost(cells[i - 1], cells[i]);
+            workspace.visit(cells[i], cells[i - 1], cost);
+        }
+    }
+
+    void cellChanged(const location_t position) override
+    {
+        if (started)
+            changed.push_back(position);
+    }
+
+    void boardCleared() override
+    {
+        started = false;
+        changed.clear();
+    }
+
+private:
+    struct Key {
+        cost_t first;
+        cost_t second;
+
+        inline bool operator< (const Key& other) const
+        {
+            return first < other.first
+                || (first == other.first && second < other.second);
+        }
+    };
+
+    graph::Board& board;
+    Heuristic heuristic;
+
+    bool started = false;
+    int columns = 0;
+
+    location_t start = {};
+    location_t goal = {};
+    cost_t km = 0;
+
+    std::vector<cost_t> g;
+    std::vector<cost_t> rhs;
+
+    // Keys go in as (first, -second): larger ties win
+    IndexedHeap<location_t, cost_t> open;
+
+    // Cells edited since the last plan()
+    std::vector<location_t> changed;
+
+    std::size_t expanded = 0;
+
+    inline std::size_t index(const location_t position) const
+    {
+        return (std::size_t) position.y * columns + position.x;
+    }
+
+    inline Key key(const location_t position) const
+    {
+        cost_t best = std::min(g[index(position)], rhs[index(position)]);
+
+        return {best + heuristic(start, position) + km, best};
+    }
+
+    inline Key topKey() const
+    {
+        return {open.topPriority(), -open.topTie()};
+    }
+
+    // Best cost to the goal through a neighbor's g
+    cost_t lookahead(const location_t position) const
+    {
+        if (position == goal)
+            return 0;
+
+        if (!board.passable(position))
+            return infinity;
+
+        cost_t best = infinity;
+
+        for (location_t next : board.template neighbors<Movement>(position))
+            best = std::min(best, board.cost(position, next) + g[index(next)]);
+
+        return best;
+    }
+
+    void updateVertex(const location_t position)
+    {
+        std::size_t i = index(position);
+
+        if (g[i] != rhs[i]) {
+            Key k = key(position);
+            open.update(position, k.first, -k.second);
+        }
+        else {
+            open.remove(position);
+        }
+    }
+
+    void initialize(const location_t start_, const location_t goal_)
+    {
+        int rows = board.getRows();
+        columns = board.getColumns();
+
+        start = start_;
+        goal = goal_;
+        km = 0;
+
+        g.assign((std::size_t) rows * columns, infinity);
+        rhs.assign((std::size_t) rows * columns, infinity);
+
+        open.reset(rows, columns);
+
+        rhs[index(goal)] = 0;
+        updateVertex(goal);
+
+        started = true;
+    }
+
+    /*
+     * Runs until start is consistent and no queued key is below its own.
+     * Paths that tie in exact arithmetic tie only to within rounding here,
+     * so keys that close to start's are expanded too: stopping early would
+     * leave start with a stale cost. False if control cancelled it first.
+     */
+    bool computeShortestPath(SearchControl* control)
+    {
+        const cost_t tolerance = (cost_t) 1 / 1048576;
+        std::size_t s = index(start);
+
+        while (!open.empty()
+            && (open.topPriority() <= key(start).first + tolerance
+                || rhs[s] != g[s]))
+        {
+            location_t current = open.top();
+            std::size_t i = index(current);
+
+            Key old_key = topKey();
+            Key new_key = key(current);
+
+            // Queued before start moved
+            if (old_key < new_key) {
+                open.update(current, new_key.first, -new_key.second);
+                continue;
+            }
+
+            if (control) {
+                if (control->cancelled())
+                    return false;
+
+                control->reportExpanded(expanded + 1);
+            }
+
+            ++expanded;
+            open.remove(current);
+
+            if (g[i] > rhs[i]) {
+                g[i] = rhs[i];
+
+                // Cells that step into current can only get cheaper
+                for (location_t previous :
+                    board.template neighbors<Movement>(current))
+                {
+                    cost_t through = board.cost(previous, current) + g[i];
+
+                    if (previous != goal && through < rhs[index(previous)]) {
+                        rhs[index(previous)] = through;
+                        updateVertex(previous);
+                    }
+                }
+            }
+            else {
+                g[i] = infinity;
+
+                rhs[i] = lookahead(current);
+                updateVertex(current);
+
+                for (location_t previous :
+                    board.template neighbors<Movement>(current))
+                {
+                    rhs[index(previous)] = lookahead(previous);
+                    updateVertex(previous);
+                }
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif /* DSTAR_LITE_H */
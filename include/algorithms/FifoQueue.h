@@ -0,0 +1,71 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef FIFOQUEUE_H
+#define FIFOQUEUE_H 1
+
+#include <cstddef>          /* std::size_t          */
+#include <vector>           /* std::vector          */
+
+/*
+ * First in, first out, with the same interface as the other frontiers so
+ * BestFirstSearch can run BFS. Priorities are ignored: when every step
+ * costs the same, insertion order already is priority order.
+ *
+ * Items live in one vector and are only moved down once most of it has been
+ * taken, so put() and get() are O(1) amortized and a frontier reused between
+ * searches stops allocating after the first one.
+ */
+template<typename T, typename priority_t>
+struct FifoQueue {
+    std::vector<T> elements;
+    std::size_t head = 0;
+
+    inline bool empty() const {
+        return head == elements.size();
+    }
+
+    inline std::size_t size() const {
+        return elements.size() - head;
+    }
+
+    inline std::size_t memoryUsage() const {
+        return elements.capacity() * sizeof(T);
+    }
+
+    // Empties the queue. The grid size is only used by IndexedHeap
+    void reset(int rows, int columns) {
+        elements.clear();
+        head = 0;
+    }
+
+    inline void put(T item, priority_t priority, priority_t tie = priority_t()) {
+        if (head >= 4096 && 2 * head >= elements.size()) {
+            elements.erase(elements.begin(), elements.begin() + head);
+            head = 0;
+        }
+
+        elements.push_back(item);
+    }
+
+    T get() {
+        return elements[head++];
+    }
+};
+
+#endif /* FIFOQUEUE_H */
@@ -0,0 +1,218 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H    1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::int8_t, std::uint8_t */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Location.h"      /* graph::Location */
+
+#include "RadixHeap.h"
+#include "SearchControl.h"
+
+/*
+ * Flow field towards one goal, for many agents heading to it at once: a
+ * single Dijkstra from the goal gives every cell its cost to the goal (the
+ * integration field) and the step that starts a cheapest path from it (the
+ * direction field). An agent anywhere then looks its next step up in O(1)
+ * instead of running its own search.
+ *
+ * Steps are recorded as the search lowers a cell's cost, so there is no
+ * separate pass to derive them. Every policy in Movement.h links cells both
+ * ways, so the cells that step into a cell are its own neighbors.
+ */
+class FlowField {
+public:
+    typedef graph::Location location_t;
+    typedef double cost_t;
+
+    static constexpr cost_t unreachable
+        = std::numeric_limits<cost_t>::infinity();
+
+    FlowField() : rows(0), columns(0), goal({0, 0}) {}
+
+    /*
+     * Floods graph (e.g. a graph::BoardView) from its goal. The monotone
+     * RadixHeap keeps this close to linear in the number of cells.
+     *
+     * control, if given, hears about every settled cell and can cancel. A
+     * cancelled build() returns false and leaves the field empty.
+     */
+    template<typename Graph>
+    bool build(const Graph& graph, SearchControl* control = nullptr)
+    {
+        rows = graph.getRows();
+        columns = graph.getColumns();
+        goal = graph.getGoal();
+
+        std::size_t n_cells = (std::size_t) rows * columns;
+
+        costs.assign(n_cells, unreachable);
+        steps.assign(n_cells, STAY);
+
+        if (!graph.passable(goal))
+            return true;
+
+        std::vector<std::uint8_t> settled(n_cells, 0);
+        std::size_t n_settled = 0;
+        RadixHeap<location_t, cost_t> frontier;
+
+        frontier.reset(rows, columns);
+        frontier.put(goal, 0);
+        costs[index(goal)] = 0;
+
+        while (!frontier.empty()) {
+            location_t current = frontier.get();
+            std::size_t i = index(current);
+
+            // Stale copy, the cell was settled through a cheaper one
+            if (settled[i])
+                continue;
+
+            settled[i] = 1;
+
+            if (control) {
+                if (control->cancelled()) {
+                    clear();
+                    return false;
+                }
+
+                control->reportExpanded(++n_settled);
+            }
+
+            for (location_t previous : graph.neighbors(current)) {
+                std::size_t j = index(previous);
+                cost_t through = costs[i] + graph.cost(previous, current);
+
+                if (!settled[j] && through < costs[j]) {
+                    costs[j] = through;
+                    steps[j] = encode(current.x - previous.x,
+                        current.y - previous.y);
+
+                    frontier.put(previous, through);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Forgets the field
+    void clear()
+    {
+        costs.clear();
+        steps.clear();
+    }
+
+    bool empty() const
+    {
+        return costs.empty();
+    }
+
+    const location_t& getGoal() const
+    {
+        return goal;
+    }
+
+    // False off the field too, or when there is no field (never built, or
+    // cancelled), so path() fails cleanly
+    inline bool reachable(const location_t position) const
+    {
+        return !empty()
+            && position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows
+            && costs[index(position)] != unreachable;
+    }
+
+    // Unchecked: position must be on a built field
+    inline cost_t costToGoal(const location_t position) const
+    {
+        return costs[index(position)];
+    }
+
+    // Where an agent at position steps next. The goal and cells that can
+    // not reach it stay put. Unchecked, like costToGoal()
+    inline location_t next(const location_t position) const
+    {
+        std::int8_t step = steps[index(position)];
+
+        return {position.x + step % 3 - 1, position.y + step / 3 - 1};
+    }
+
+    // from ~> goal, both included, following the field. False (and empty)
+    // if from can not reach the goal
+    bool path(const location_t from, std::vector<location_t>& cells) const
+    {
+        cells.clear();
+
+        if (!reachable(from))
+            return false;
+
+        location_t current = from;
+        cells.push_back(current);
+
+        while (current != goal) {
+            current = next(current);
+            cells.push_back(current);
+        }
+
+        return true;
+    }
+
+    // Leaves the field in a SearchWorkspace: each cell's cost to the goal,
+    // with its next step as came_from
+    template<typename Workspace>
+    void exportTo(Workspace& workspace) const
+    {
+        workspace.resize(rows, columns);
+        workspace.reset();
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                if (reachable({x, y}))
+                    workspace.visit({x, y}, next({x, y}), costToGoal({x, y}));
+            }
+        }
+    }
+
+private:
+    // Steps are (dx + 1) + 3 * (dy + 1), so 4 is no step at all
+    static constexpr std::int8_t STAY = 4;
+
+    int rows, columns;
+    location_t goal;
+
+    std::vector<cost_t> costs;
+    std::vector<std::int8_t> steps;
+
+    inline std::size_t index(const location_t position) const
+    {
+        return (std::size_t) position.y * columns + position.x;
+    }
+
+    static inline std::int8_t encode(const int dx, const int dy)
+    {
+        return (std::int8_t) ((dx + 1) + 3 * (dy + 1));
+    }
+};
+
+#endif /* FLOW_FIELD_H */
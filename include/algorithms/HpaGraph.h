@@ -0,0 +1,363 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef HPA_GRAPH_H
+#define HPA_GRAPH_H     1
+
+#include <algorithm>        /* std::min             */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::int16_t         */
+#include <limits>           /* std::numeric_limits  */
+#include <utility>          /* std::pair            */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board, graph::BoardListener */
+#include "../graph/ClusterView.h"   /* graph::Area, graph::ClusterView */
+
+#include "dijkstra.h"
+
+/*
+ * Abstract graph for HPA* (Botea, Müller and Schaeffer, 2004).
+ *
+ * The board is split into square clusters of cluster_size cells. Wherever
+ * two neighboring clusters share a run of free cells along their border
+ * there is an entrance: one crossing in its middle, or one at each end if
+ * it is at least HPA_WIDE_ENTRANCE cells long. The cells at both sides of
+ * each crossing are the abstract nodes, and the cost between every two
+ * nodes of a cluster is precomputed with a search that stays inside it.
+ *
+ * The graph listens to the board. An edit only marks the cluster it falls
+ * in, and the neighbor across the border if it is on one, and marked
+ * clusters are rebuilt on the next refresh(). See hpa_star.h for queries.
+ */
+
+#ifndef HPA_WIDE_ENTRANCE
+    #define HPA_WIDE_ENTRANCE   6
+#endif
+
+template<typename Movement>
+class HpaGraph final : public graph::BoardListener {
+public:
+    typedef graph::Location location_t;
+    typedef double cost_t;
+
+    static constexpr cost_t unreachable = std::numeric_limits<cost_t>::max();
+
+    struct Cluster {
+        graph::Area area;
+
+        std::vector<location_t> nodes;
+        // (node, cell across the border it crosses to)
+        std::vector<std::pair<int, location_t>> links;
+        // distances[i * nodes.size() + j] from node i to node j
+        std::vector<cost_t> distances;
+
+        bool dirty;
+    };
+
+    HpaGraph(graph::Board& board_, const int cluster_size_ = 16)
+    : board(board_), cluster_size(cluster_size_)
+    {
+        board.addListener(this);
+        invalidateAll();
+    }
+
+    ~HpaGraph()
+    {
+        board.removeListener(this);
+    }
+
+    HpaGraph(const HpaGraph&) = delete;
+    HpaGraph& operator= (const HpaGraph&) = delete;
+
+    // Rebuilds the clusters edited since the last call. The workspace is
+    // only used as scratch space for the searches inside each cluster
+    template<typename Workspace>
+    void refresh(Workspace& workspace)
+    {
+        for (int id : dirty) {
+            if (clusters[id].dirty)
+                rebuild(clusters[id], workspace);
+        }
+
+        dirty.clear();
+    }
+
+    // Whether refresh() has anything to do
+    bool stale() const
+    {
+        return !dirty.empty();
+    }
+
+    inline int clusterOf(const location_t position) const
+    {
+        return (position.y / cluster_size) * cluster_columns
+            + position.x / cluster_size;
+    }
+
+    inline const Cluster& cluster(const int id) const
+    {
+        return clusters[id];
+    }
+
+    // Index of position among the nodes of its cluster, or -1
+    inline int nodeIndex(const location_t position) const
+    {
+        return node_of[(std::size_t) position.y * board.getColumns()
+            + position.x];
+    }
+
+    const graph::Board& getBoard() const
+    {
+        return board;
+    }
+
+    std::size_t countNodes() const
+    {
+        std::size_t count = 0;
+
+        for (const Cluster& each : clusters)
+            count += each.nodes.size();
+
+        return count;
+    }
+
+    void cellChanged(const location_t position) override
+    {
+        const graph::Area& area = clusters[clusterOf(position)].area;
+
+        // Entrances depend on the cells at both sides of a border, and
+        // diagonal crossings on the cells around a corner too
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                location_t next = {position.x + dx, position.y + dy};
+
+                if (board.in_bounds(next)
+                    && (next == position || !area.contains(next)))
+                {
+                    invalidate(clusterOf(next));
+                }
+            }
+        }
+    }
+
+    void boardCleared() override
+    {
+        invalidateAll();
+    }
+
+private:
+    graph::Board& board;
+
+    int cluster_size;
+    int cluster_columns = 0;
+
+    std::vector<Cluster> clusters;
+    std::vector<int> dirty;
+
+    // nodeIndex() of every cell
+    std::vector<std::int16_t> node_of;
+
+    void invalidate(const int id)
+    {
+        if (!clusters[id].dirty) {
+            clusters[id].dirty = true;
+            dirty.push_back(id);
+        }
+    }
+
+    void invalidateAll()
+    {
+        int rows = board.getRows(), columns = board.getColumns();
+
+        cluster_columns = (columns + cluster_size - 1) / cluster_size;
+        int cluster_rows = (rows + cluster_size - 1) / cluster_size;
+
+        clusters.assign((std::size_t) cluster_rows * cluster_columns,
+            Cluster());
+        node_of.assign((std::size_t) rows * columns, -1);
+        dirty.clear();
+
+        for (int i = 0; i < cluster_rows; ++i) {
+            for (int j = 0; j < cluster_columns; ++j) {
+                Cluster& each = clusters[i * cluster_columns + j];
+
+                each.area.top_left = {j * cluster_size, i * cluster_size};
+                each.area.bottom_right = {
+                    std::min(columns, (j + 1) * cluster_size),
+                    std::min(rows, (i + 1) * cluster_size)
+                };
+                each.dirty = false;
+
+                invalidate(i * cluster_columns + j);
+            }
+        }
+    }
+
+    /*
+     * Crossings along one side of a cluster: length cells starting at first
+     * and advancing by step, each one facing the cell at + across.
+     */
+    void addEntrances(
+        Cluster& owner,
+        const location_t first, const location_t step,
+        const location_t across, const int length
+    )
+    {
+        int run = 0;
+
+        for (int k = 0; k <= length; ++k) {
+            location_t inside = {first.x + k * step.x, first.y + k * step.y};
+            location_t outside = {inside.x + across.x, inside.y + across.y};
+
+            if (k < length && board.passable(inside)
+                && board.passable(outside))
+            {
+                ++run;
+                continue;
+            }
+
+            if (run == 0)
+                continue;
+
+            // The run covered cells k - run to k - 1
+            if (run < HPA_WIDE_ENTRANCE) {
+                crossAt(owner, k - run + (run - 1) / 2, first, step, across);
+            }
+            else {
+                crossAt(owner, k - run, first, step, across);
+                crossAt(owner, k - 1, first, step, across);
+            }
+
+            run = 0;
+        }
+    }
+
+    void crossAt(
+        Cluster& owner, const int k,
+        const location_t first, const location_t step,
+        const location_t across
+    )
+    {
+        location_t inside = {first.x + k * step.x, first.y + k * step.y};
+
+        addCrossing(owner, inside, {inside.x + across.x, inside.y + across.y});
+    }
+
+    inline void setNodeIndex(const location_t position, const int node)
+    {
+        node_of[(std::size_t) position.y * board.getColumns() + position.x]
+            = (std::int16_t) node;
+    }
+
+    void addCrossing(
+        Cluster& owner, const location_t inside, const location_t outside
+    )
+    {
+        int node = nodeIndex(inside);
+
+        if (node < 0) {
+            node = (int) owner.nodes.size();
+            owner.nodes.push_back(inside);
+            setNodeIndex(inside, node);
+        }
+
+        owner.links.push_back({node, outside});
+    }
+
+    /*
+     * Diagonal steps out of the cluster whose orthogonal cells are both
+     * walls. Only policies that cut corners have them, and no entrance
+     * covers them.
+     */
+    void addDiagonalCrossings(Cluster& owner)
+    {
+        const graph::Area& area = owner.area;
+
+        for (int y = area.top_left.y; y < area.bottom_right.y; ++y) {
+            for (int x = area.top_left.x; x < area.bottom_right.x; ++x) {
+                location_t inside = {x, y};
+
+                if (!area.contains({x - 1, y - 1})
+                    || !area.contains({x + 1, y + 1}))
+                {
+                    for (location_t next :
+                        board.template neighbors<Movement>(inside))
+                    {
+                        if (!area.contains(next) && next.x != x
+                            && next.y != y && !board.passable({next.x, y})
+                            && !board.passable({x, next.y}))
+                        {
+                            addCrossing(owner, inside, next);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename Workspace>
+    void rebuild(Cluster& owner, Workspace& workspace)
+    {
+        const graph::Area& area = owner.area;
+        const location_t& a = area.top_left;
+        const location_t& b = area.bottom_right;
+
+        int width = b.x - a.x, height = b.y - a.y;
+
+        for (const location_t& node : owner.nodes)
+            setNodeIndex(node, -1);
+
+        owner.nodes.clear();
+        owner.links.clear();
+
+        if (a.y > 0)
+            addEntrances(owner, a, {1, 0}, {0, -1}, width);
+        if (b.y < board.getRows())
+            addEntrances(owner, {a.x, b.y - 1}, {1, 0}, {0, 1}, width);
+        if (a.x > 0)
+            addEntrances(owner, a, {0, 1}, {-1, 0}, height);
+        if (b.x < board.getColumns())
+            addEntrances(owner, {b.x - 1, a.y}, {0, 1}, {1, 0}, height);
+
+        if (Movement::diagonals)
+            addDiagonalCrossings(owner);
+
+        std::size_t n = owner.nodes.size();
+        owner.distances.assign(n * n, unreachable);
+
+        // One flood per node; the goal is off the board so it never stops
+        for (std::size_t i = 0; i < n; ++i) {
+            graph::ClusterView<Movement> view(
+                board, area, owner.nodes[i], {-1, -1}
+            );
+
+            dijkstra_search(view, workspace);
+
+            for (std::size_t j = 0; j < n; ++j) {
+                if (workspace.visited(owner.nodes[j]))
+                    owner.distances[i * n + j]
+                        = workspace.costSoFar(owner.nodes[j]);
+            }
+        }
+
+        owner.dirty = false;
+    }
+};
+
+#endif /* HPA_GRAPH_H */
@@ -0,0 +1,252 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H   1
+
+#include <algorithm>        /* std::fill            */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint32_t        */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+/*
+ * d-ary min-heap (4-ary by default) that knows where each cell sits, so an
+ * item is only ever queued once: putting it again with a better priority is a
+ * decrease-key, not a duplicate. The frontier can't grow past the number of
+ * cells and no stale entries are popped.
+ *
+ * Items are grid locations, indexed by y * columns + x; call
+ * reset(rows, columns) before use. Like SearchWorkspace, the cell -> slot map
+ * is stamped with an epoch, so reset() on the same grid is O(1).
+ *
+ * Ties on priority go to the larger tie value, as in PriorityQueue.
+ */
+template<typename T, typename priority_t, int Arity = 4>
+class IndexedHeap {
+public:
+    IndexedHeap() : columns(0), epoch(1) {}
+
+    // Empties the heap, sized for a rows x columns grid
+    void reset(int rows_, int columns_) {
+        std::size_t area = (std::size_t) rows_ * columns_;
+
+        heap.clear();
+
+        if (area != slots.size() || columns_ != columns) {
+            columns = columns_;
+
+            slots.assign(area, 0);
+            stamps.assign(area, 0);
+            epoch = 1;
+        }
+        else if (epoch == std::numeric_limits<std::uint32_t>::max()) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+        else {
+            ++epoch;
+        }
+    }
+
+    inline bool empty() const {
+        return heap.empty();
+    }
+
+    inline std::size_t size() const {
+        return heap.size();
+    }
+
+    inline std::size_t memoryUsage() const {
+        return heap.capacity() * sizeof(Node)
+            + (slots.capacity() + stamps.capacity()) * sizeof(std::uint32_t);
+    }
+
+    inline bool contains(const T& item) const {
+        return stamps[index(item)] == epoch;
+    }
+
+    // Inserts item, or lowers its priority if it is already queued
+    inline void put(T item, priority_t priority, priority_t tie = priority_t()) {
+        std::size_t cell = index(item);
+
+        if (stamps[cell] != epoch) {
+            push(cell, item, priority, tie);
+        }
+        else {
+            std::size_t slot = slots[cell];
+            Node candidate = {priority, -tie, item, (std::uint32_t) cell};
+
+            if (less(candidate, heap[slot])) {
+                heap[slot] = candidate;
+                siftUp(slot);
+            }
+        }
+    }
+
+    // Sets item's priority, higher or lower, inserting it if needed
+    void update(T item, priority_t priority, priority_t tie = priority_t()) {
+        std::size_t cell = index(item);
+
+        if (stamps[cell] != epoch) {
+            push(cell, item, priority, tie);
+            return;
+        }
+
+        std::size_t slot = slots[cell];
+
+        heap[slot].priority = priority;
+        heap[slot].tie = -tie;
+
+        siftUp(slot);
+        siftDown(slots[cell]);
+    }
+
+    void remove(const T& item) {
+        std::size_t cell = index(item);
+
+        if (stamps[cell] != epoch)
+            return;
+
+        std::size_t slot = slots[cell];
+        stamps[cell] = 0;
+
+        Node moved = heap.back();
+        heap.pop_back();
+
+        if (slot < heap.size()) {
+            // The last node fills the hole, then finds its place
+            place(slot, moved);
+
+            siftUp(slot);
+            siftDown(slots[moved.index]);
+        }
+    }
+
+    inline const T& top() const {
+        return heap[0].item;
+    }
+
+    inline priority_t topPriority() const {
+        return heap[0].priority;
+    }
+
+    // Tie value top() was put with
+    inline priority_t topTie() const {
+        return -heap[0].tie;
+    }
+
+    inline priority_t priorityOf(const T& item) const {
+        return heap[slots[index(item)]].priority;
+    }
+
+    T get() {
+        T best_item = heap[0].item;
+
+        remove(best_item);
+
+        return best_item;
+    }
+
+private:
+    struct Node {
+        priority_t priority;
+        priority_t tie;         // Negated, smaller first
+        T item;
+        std::uint32_t index;    // Cell index of item
+    };
+
+    int columns;
+    std::uint32_t epoch;
+
+    std::vector<Node> heap;
+    std::vector<std::uint32_t> slots;       // Cell index -> position in heap
+    std::vector<std::uint32_t> stamps;      // == epoch while in the heap
+
+    inline std::size_t index(const T& item) const {
+        return (std::size_t) item.y * columns + item.x;
+    }
+
+    static inline bool less(const Node& a, const Node& b) {
+        return a.priority < b.priority
+            || (!(b.priority < a.priority) && a.tie < b.tie);
+    }
+
+    inline void place(const std::size_t slot, const Node& node) {
+        heap[slot] = node;
+        slots[node.index] = slot;
+    }
+
+    void push(
+        const std::size_t cell, const T& item,
+        const priority_t priority, const priority_t tie
+    ) {
+        stamps[cell] = epoch;
+
+        heap.push_back({priority, -tie, item, (std::uint32_t) cell});
+        slots[cell] = heap.size() - 1;
+
+        siftUp(heap.size() - 1);
+    }
+
+    void siftUp(std::size_t slot) {
+        Node node = heap[slot];
+
+        while (slot > 0) {
+            std::size_t parent = (slot - 1) / Arity;
+
+            if (!less(node, heap[parent]))
+                break;
+
+            place(slot, heap[parent]);
+            slot = parent;
+        }
+
+        place(slot, node);
+    }
+
+    void siftDown(std::size_t slot) {
+        Node node = heap[slot];
+        std::size_t n = heap.size();
+
+        while (true) {
+            std::size_t first = slot * Arity + 1;
+
+            if (first >= n)
+                break;
+
+            std::size_t best = first;
+            std::size_t last = first + Arity < n ? first + Arity : n;
+
+            for (std::size_t child = first + 1; child < last; ++child) {
+                if (less(heap[child], heap[best]))
+                    best = child;
+            }
+
+            if (!less(heap[best], node))
+                break;
+
+            place(slot, heap[best]);
+            slot = best;
+        }
+
+        place(slot, node);
+    }
+};
+
+#endif /* INDEXEDHEAP_H */
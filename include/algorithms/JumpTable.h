@@ -0,0 +1,261 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef JUMP_TABLE_H
+#define JUMP_TABLE_H    1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::int16_t         */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board, graph::BoardListener */
+#include "../graph/BoardView.h"     /* graph::BoardView */
+
+#include "jps.h"            /* jps_can_step, jps_forced */
+
+/*
+ * JPS+ preprocessing (Rabin, Game AI Pro 2). For every cell and each of the
+ * 8 directions of Movement::DIRS it stores how far the next jump point is:
+ *
+ *  d > 0   the cell d steps away is a jump point
+ *  d <= 0  there is none, and -d steps can be taken before hitting a wall
+ *
+ * Jump points are the ones jps_search() finds, but without a goal, so a
+ * query only has to look for the goal along the way (see jps_plus.h).
+ *
+ * The table listens to the board. Changing a cell only rebuilds the rows and
+ * columns next to it, then walks back along the diagonals that ran into
+ * them until their values stop changing.
+ */
+template<typename Movement>
+class JumpTable final : public graph::BoardListener {
+public:
+    typedef graph::Location location_t;
+    typedef std::int16_t distance_t;
+
+    static_assert(Movement::diagonals, "JPS+ needs diagonal moves");
+
+    explicit JumpTable(graph::Board& board_)
+    : board(board_), view(board_)
+    {
+        board.addListener(this);
+        build();
+    }
+
+    ~JumpTable()
+    {
+        board.removeListener(this);
+    }
+
+    JumpTable(const JumpTable&) = delete;
+    JumpTable& operator= (const JumpTable&) = delete;
+
+    // Recomputes every distance
+    void build()
+    {
+        rows = board.getRows();
+        columns = board.getColumns();
+
+        distances.assign((std::size_t) rows * columns * Movement::n_dirs, 0);
+
+        // Diagonals read the straight distances, so those go first
+        for (int dir = 0; dir < Movement::n_dirs; ++dir) {
+            const location_t& d = Movement::DIRS[dir];
+
+            for (int i = 0; i < rows; ++i) {
+                int y = (d.y > 0) ? rows - 1 - i : i;
+
+                for (int j = 0; j < columns; ++j) {
+                    int x = (d.x > 0) ? columns - 1 - j : j;
+
+                    at({x, y}, dir) = compute({x, y}, dir);
+                }
+            }
+        }
+    }
+
+    // Patches the distances after the walls around position changed
+    void update(const location_t position)
+    {
+        if (board.getRows() != rows || board.getColumns() != columns) {
+            build();
+            return;
+        }
+
+        for (int dir = 0; dir < Movement::n_dirs; ++dir) {
+            const location_t& d = Movement::DIRS[dir];
+
+            if (d.x != 0 && d.y != 0)
+                continue;
+
+            // A straight distance depends on its own line and on the
+            // forced neighbors of the lines at each side
+            for (int k = -1; k <= 1; ++k) {
+                if (d.y == 0)
+                    sweepRow(position.y + k, dir);
+                else
+                    sweepColumn(position.x + k, dir);
+            }
+        }
+
+        for (int dir = 0; dir < Movement::n_dirs; ++dir) {
+            const location_t& d = Movement::DIRS[dir];
+
+            if (d.x == 0 || d.y == 0)
+                continue;
+
+            // Every cell whose next diagonal step lands on a changed row or
+            // column. Anything further back only changes through them
+            for (int k = -1; k <= 1; ++k) {
+                int y = position.y + k - d.y;
+                int x = position.x + k - d.x;
+
+                for (int i = 0; i < columns; ++i)
+                    propagate({i, y}, dir);
+
+                for (int i = 0; i < rows; ++i)
+                    propagate({x, i}, dir);
+            }
+        }
+    }
+
+    inline distance_t distance(const location_t position, const int dir) const
+    {
+        return distances[index(position) + dir];
+    }
+
+    // Index of (dx, dy) in Movement::DIRS
+    static inline int direction(const int dx, const int dy)
+    {
+        for (int dir = 0; dir < Movement::n_dirs; ++dir) {
+            if (Movement::DIRS[dir].x == dx && Movement::DIRS[dir].y == dy)
+                return dir;
+        }
+
+        return -1;
+    }
+
+    void cellChanged(const location_t position) override
+    {
+        update(position);
+    }
+
+    void boardCleared() override
+    {
+        build();
+    }
+
+private:
+    // Longer distances are cut short with a jump point that only continues
+    // in the same direction, so they fit in a distance_t
+    static constexpr int max_distance = std::numeric_limits<distance_t>::max();
+
+    graph::Board& board;
+    graph::BoardView<Movement> view;
+
+    int rows = 0, columns = 0;
+    std::vector<distance_t> distances;
+
+    inline std::size_t index(const location_t position) const
+    {
+        return ((std::size_t) position.y * columns + position.x)
+            * Movement::n_dirs;
+    }
+
+    inline distance_t& at(const location_t position, const int dir)
+    {
+        return distances[index(position) + dir];
+    }
+
+    // Distance for position, given the one of the cell after it
+    distance_t compute(const location_t position, const int dir) const
+    {
+        const location_t& d = Movement::DIRS[dir];
+
+        if (!view.passable(position) || !jps_can_step(view, position, d.x, d.y))
+            return 0;
+
+        location_t next = {position.x + d.x, position.y + d.y};
+
+        if (jps_forced(view, next, d.x, d.y))
+            return 1;
+
+        if (d.x != 0 && d.y != 0
+            && (distance(next, direction(d.x, 0)) > 0
+                || distance(next, direction(0, d.y)) > 0))
+        {
+            return 1;
+        }
+
+        int after = distance(next, dir);
+
+        if (after > 0)
+            return (after < max_distance) ? after + 1 : 1;
+
+        return (after > -max_distance) ? after - 1 : 1;
+    }
+
+    void sweepRow(const int y, const int dir)
+    {
+        if (y < 0 || y >= rows)
+            return;
+
+        bool east = Movement::DIRS[dir].x > 0;
+
+        for (int j = 0; j < columns; ++j) {
+            location_t position = {east ? columns - 1 - j : j, y};
+
+            at(position, dir) = compute(position, dir);
+        }
+    }
+
+    void sweepColumn(const int x, const int dir)
+    {
+        if (x < 0 || x >= columns)
+            return;
+
+        bool south = Movement::DIRS[dir].y > 0;
+
+        for (int i = 0; i < rows; ++i) {
+            location_t position = {x, south ? rows - 1 - i : i};
+
+            at(position, dir) = compute(position, dir);
+        }
+    }
+
+    // Recomputes position, and the cells behind it while they change
+    void propagate(location_t position, const int dir)
+    {
+        const location_t& d = Movement::DIRS[dir];
+
+        while (board.in_bounds(position)) {
+            distance_t value = compute(position, dir);
+
+            if (value == distance(position, dir))
+                return;
+
+            at(position, dir) = value;
+
+            position.x -= d.x;
+            position.y -= d.y;
+        }
+    }
+};
+
+#endif /* JUMP_TABLE_H */
@@ -0,0 +1,428 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef LANDMARKS_H
+#define LANDMARKS_H     1
+
+#include <algorithm>        /* std::max, std::min   */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::int32_t, std::uint64_t */
+#include <cstring>          /* std::memcmp          */
+#include <fstream>          /* std::ifstream, std::ofstream */
+#include <ios>              /* std::streamoff       */
+#include <limits>           /* std::numeric_limits  */
+#include <string>           /* std::string          */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Board.h"         /* graph::Board, graph::BoardListener */
+#include "../graph/BoardView.h"     /* graph::BoardView */
+#include "../graph/ClusterView.h"   /* graph::ClusterView */
+
+#include "dijkstra.h"
+#include "heuristics.h"     /* MatchedHeuristic     */
+
+/*
+ * Landmark tables for ALT (A*, landmarks and triangle inequality; Goldberg
+ * and Harrelson, 2005).
+ *
+ * For each landmark L the table holds d(L, v) and d(v, L) for every cell v.
+ * They differ, as costs are charged on the cell being entered. By the
+ * triangle inequality both d(L, t) - d(L, v) and d(v, L) - d(t, L) are lower
+ * bounds of d(v, t), and so is the largest of them over all landmarks. Near
+ * a landmark "behind" the goal that bound is almost exact, walls and weights
+ * included, which octile distance can not see.
+ *
+ * Landmarks are picked one by one, each as far as possible from the ones
+ * before (farthest-point selection). Distances are stored as floats, cell
+ * by cell, so one lookup reads all the landmarks of a cell at once.
+ *
+ * Any edit makes every distance suspect, so the tables listen to the board
+ * and stop being ready() on the first change. build() again, or load() a
+ * file saved for the board as it is now.
+ */
+template<typename Movement>
+class Landmarks final : public graph::BoardListener {
+public:
+    typedef graph::Location location_t;
+    typedef float distance_t;
+
+    static constexpr distance_t unreachable
+        = std::numeric_limits<distance_t>::infinity();
+
+    explicit Landmarks(graph::Board& board_)
+    : board(board_), fresh(false)
+    {
+        board.addListener(this);
+    }
+
+    ~Landmarks()
+    {
+        board.removeListener(this);
+    }
+
+    Landmarks(const Landmarks&) = delete;
+    Landmarks& operator= (const Landmarks&) = delete;
+
+    /*
+     * Picks count landmarks and runs a forward and a backward Dijkstra from
+     * each one. The workspace is only used as scratch space.
+     */
+    template<typename Workspace>
+    void build(const int count, Workspace& workspace)
+    {
+        rows = board.getRows();
+        columns = board.getColumns();
+
+        std::size_t n_cells = (std::size_t) rows * columns;
+
+        landmarks.clear();
+        forward.clear();
+        backward.clear();
+
+        // Search from the start, the first free cell otherwise
+        location_t seed = board.getStart();
+
+        for (std::size_t i = 0; i < n_cells && !board.passable(seed); ++i)
+            seed = {(int) (i % columns), (int) (i / columns)};
+
+        if (count < 1 || !board.passable(seed)) {
+            fresh = true;
+            return;
+        }
+
+        // Distance from each cell to the closest landmark so far. The first
+        // landmark is the cell farthest from the seed
+        std::vector<distance_t> nearest(n_cells, unreachable);
+
+        flood(graph::BoardView<Movement>(board, seed, {-1, -1}), workspace,
+            nearest);
+
+        std::vector<distance_t> from(n_cells), to(n_cells);
+
+        for (int k = 0; k < count; ++k) {
+            location_t landmark = seed;
+            distance_t farthest = -1;
+
+            for (std::size_t i = 0; i < n_cells; ++i) {
+                if (nearest[i] != unreachable && nearest[i] > farthest) {
+                    farthest = nearest[i];
+                    landmark = {(int) (i % columns), (int) (i / columns)};
+                }
+            }
+
+            // Every reachable cell already is a landmark
+            if (farthest <= 0 && k > 0)
+                break;
+
+            from.assign(n_cells, unreachable);
+            to.assign(n_cells, unreachable);
+
+            flood(graph::BoardView<Movement>(board, landmark, {-1, -1}),
+                workspace, from);
+            flood(graph::ClusterView<Movement>(board,
+                    {{0, 0}, {columns, rows}}, landmark, {-1, -1}, true),
+                workspace, to);
+
+            landmarks.push_back(landmark);
+
+            for (std::size_t i = 0; i < n_cells; ++i) {
+                nearest[i] = (k == 0)
+                    ? from[i] : std::min(nearest[i], from[i]);
+            }
+
+            interleave(from, forward);
+            interleave(to, backward);
+        }
+
+        measureSlack();
+        fresh = true;
+    }
+
+    // Binary dump of the tables and of the board they describe. Native byte
+    // order, so files are not meant to move between machines
+    bool save(const std::string& filename) const
+    {
+        if (!fresh)
+            return false;
+
+        std::ofstream file(filename, std::ios::binary);
+
+        Header header = makeHeader();
+
+        file.write((const char*) &header, sizeof(header));
+        file.write((const char*) landmarks.data(),
+            landmarks.size() * sizeof(location_t));
+        file.write((const char*) forward.data(),
+            forward.size() * sizeof(distance_t));
+        file.write((const char*) backward.data(),
+            backward.size() * sizeof(distance_t));
+
+        return (bool) file;
+    }
+
+    // Fails, leaving the tables as they were, unless the file was saved for
+    // the same movement policy and a board with the same cells
+    bool load(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        Header header, expected;
+
+        rows = board.getRows();
+        columns = board.getColumns();
+
+        expected = makeHeader();
+
+        if (!file.read((char*) &header, sizeof(header))
+            || std::memcmp(header.magic, expected.magic, sizeof(header.magic))
+            || header.rows != expected.rows
+            || header.columns != expected.columns
+            || header.n_dirs != expected.n_dirs
+            || header.corner_cutting != expected.corner_cutting
+            || header.cells != expected.cells
+            || header.count < 0
+            || (std::size_t) rows * columns < (std::size_t) header.count)
+        {
+            return false;
+        }
+
+        std::size_t n_values = (std::size_t) header.count * rows * columns;
+
+        // Nothing is allocated for a count the rest of the file can not hold
+        std::streamoff tables = file.tellg();
+        file.seekg(0, std::ios::end);
+        std::streamoff file_end = file.tellg();
+        file.seekg(tables);
+
+        if (!file || (std::size_t) (file_end - tables)
+            != header.count * sizeof(location_t)
+                + 2 * n_values * sizeof(distance_t))
+        {
+            return false;
+        }
+
+        std::vector<location_t> read_landmarks(header.count);
+        std::vector<distance_t> read_forward(n_values);
+        std::vector<distance_t> read_backward(n_values);
+
+        file.read((char*) read_landmarks.data(),
+            read_landmarks.size() * sizeof(location_t));
+        file.read((char*) read_forward.data(),
+            n_values * sizeof(distance_t));
+        file.read((char*) read_backward.data(),
+            n_values * sizeof(distance_t));
+
+        if (!file)
+            return false;
+
+        landmarks.swap(read_landmarks);
+        forward.swap(read_forward);
+        backward.swap(read_backward);
+
+        measureSlack();
+        fresh = true;
+
+        return true;
+    }
+
+    // Whether the tables match the board. Until then lowerBound() is 0
+    bool ready() const
+    {
+        return fresh;
+    }
+
+    const std::vector<location_t>& getLandmarks() const
+    {
+        return landmarks;
+    }
+
+    // Largest bound on the cost of from ~> to that the landmarks give
+    inline double lowerBound(const location_t from, const location_t to) const
+    {
+        std::size_t count = landmarks.size();
+
+        if (!fresh || count == 0)
+            return 0;
+
+        const distance_t* forward_from = &forward[cellIndex(from) * count];
+        const distance_t* forward_to = &forward[cellIndex(to) * count];
+        const distance_t* backward_from = &backward[cellIndex(from) * count];
+        const distance_t* backward_to = &backward[cellIndex(to) * count];
+
+        distance_t bound = 0;
+
+        for (std::size_t k = 0; k < count; ++k) {
+            // Cells the landmark can not reach (nor be reached from)
+            if (forward_from[k] == unreachable || forward_to[k] == unreachable)
+                continue;
+
+            bound = std::max(bound, forward_to[k] - forward_from[k]);
+            bound = std::max(bound, backward_from[k] - backward_to[k]);
+        }
+
+        // Float rounding can push the bound a little above the real cost
+        return std::max(bound - slack, (distance_t) 0);
+    }
+
+    void cellChanged(const location_t position) override
+    {
+        fresh = false;
+    }
+
+    void boardCleared() override
+    {
+        fresh = false;
+    }
+
+private:
+    struct Header {
+        char magic[8];
+        std::int32_t rows, columns;
+        std::int32_t n_dirs, corner_cutting;
+        std::int32_t count;
+        // Fingerprint of the cells, see cellsHash()
+        std::uint64_t cells;
+    };
+
+    graph::Board& board;
+
+    int rows = 0, columns = 0;
+    bool fresh;
+
+    // Largest rounding error of a bound
+    distance_t slack = 0;
+
+    std::vector<location_t> landmarks;
+    // forward[cell * landmarks.size() + k] = d(landmark k, cell),
+    // backward[...] = d(cell, landmark k)
+    std::vector<distance_t> forward;
+    std::vector<distance_t> backward;
+
+    inline std::size_t cellIndex(const location_t position) const
+    {
+        return (std::size_t) position.y * columns + position.x;
+    }
+
+    template<typename Graph, typename Workspace>
+    void flood(
+        const Graph& graph, Workspace& workspace,
+        std::vector<distance_t>& distances
+    )
+    {
+        dijkstra_search(graph, workspace);
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                if (workspace.visited({x, y}))
+                    distances[cellIndex({x, y})]
+                        = (distance_t) workspace.costSoFar({x, y});
+            }
+        }
+    }
+
+    void measureSlack()
+    {
+        distance_t largest = 0;
+
+        for (const std::vector<distance_t>* table : {&forward, &backward}) {
+            for (distance_t distance : *table) {
+                if (distance != unreachable)
+                    largest = std::max(largest, distance);
+            }
+        }
+
+        // Each bound subtracts two rounded distances
+        slack = 2 * largest * std::numeric_limits<distance_t>::epsilon();
+    }
+
+    // Appends one more landmark to a cell by cell table
+    void interleave(
+        const std::vector<distance_t>& distances,
+        std::vector<distance_t>& table
+    )
+    {
+        std::size_t count = landmarks.size();
+        std::vector<distance_t> merged(distances.size() * count);
+
+        for (std::size_t i = 0; i < distances.size(); ++i) {
+            for (std::size_t k = 0; k + 1 < count; ++k)
+                merged[i * count + k] = table[i * (count - 1) + k];
+
+            merged[i * count + count - 1] = distances[i];
+        }
+
+        table.swap(merged);
+    }
+
+    // FNV-1a over what a search sees of each cell
+    std::uint64_t cellsHash() const
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                std::uint8_t cell = board.passable({x, y})
+                    ? (std::uint8_t) board.cost({x, y}, {x, y}) : 0;
+
+                hash = (hash ^ cell) * 1099511628211ull;
+            }
+        }
+
+        return hash;
+    }
+
+    Header makeHeader() const
+    {
+        Header header = {
+            {'P', 'N', 'D', 'R', 'A', 'L', 'T', '1'},
+            rows, columns,
+            Movement::n_dirs, Movement::corner_cutting,
+            (std::int32_t) landmarks.size(),
+            cellsHash()
+        };
+
+        return header;
+    }
+};
+
+/*
+ * ALT heuristic for a_star_search: the landmark bound, or base when it is
+ * larger (e.g. next to the goal) or the tables are not ready. Both are
+ * consistent, so their maximum is too, up to the rounding of the float
+ * tables.
+ */
+template<
+    typename Movement,
+    typename Base = typename MatchedHeuristic<Movement>::type
+>
+struct AltHeuristic {
+    const Landmarks<Movement>* landmarks;
+    Base base;
+
+    explicit AltHeuristic(
+        const Landmarks<Movement>& landmarks_, Base base_ = Base()
+    )
+    : landmarks(&landmarks_), base(base_) {}
+
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        return std::max(base(a, b), landmarks->lowerBound(a, b));
+    }
+};
+
+#endif /* LANDMARKS_H */
@@ -18,9 +18,21 @@
 #ifndef PRIORITYQUEUE_H
 #define PRIORITYQUEUE_H 1
 
+#include <cstddef>          /* std::size_t          */
+#include <functional>       /* std::greater         */
+#include <queue>            /* std::priority_queue  */
+#include <tuple>            /* std::tuple           */
+#include <vector>           /* std::vector          */
+
+/*
+ * Among items with the same priority, the one put with the larger tie value
+ * comes out first. A* passes the cost so far there: on equal f it keeps
+ * digging the deepest node instead of widening the whole f plateau.
+ */
 template<typename T, typename priority_t>
 struct PriorityQueue {
-    typedef std::pair<priority_t, T> PQElement;
+    // The tie value is stored negated so std::greater orders it descending
+    typedef std::tuple<priority_t, priority_t, T> PQElement;
 
     std::priority_queue<PQElement, std::vector<PQElement>,
         std::greater<PQElement>> elements; // greater to have smaller first
@@ -29,12 +41,39 @@ struct PriorityQueue {
         return elements.empty();
     }
 
-    inline void put(T item, priority_t priority) {
-        elements.emplace(priority, item);
+    inline std::size_t size() const {
+        return elements.size();
+    }
+
+    // std::priority_queue keeps its vector protected, so this reaches it
+    // through a derived class
+    std::size_t memoryUsage() const {
+        struct Container : decltype(elements) {
+            static std::size_t capacity(const decltype(elements)& queue) {
+                return (queue.*&Container::c).capacity();
+            }
+        };
+
+        return Container::capacity(elements) * sizeof(PQElement);
+    }
+
+    // Empties the queue. The grid size is only used by IndexedHeap
+    void reset(int rows, int columns) {
+        elements = decltype(elements)();
+    }
+
+    inline void put(T item, priority_t priority, priority_t tie = priority_t()) {
+        elements.emplace(priority, -tie, item);
+    }
+
+    // Smallest priority in the queue, which must not be empty. It may
+    // belong to a stale entry, but never to one above the real minimum
+    inline priority_t topPriority() const {
+        return std::get<0>(elements.top());
     }
 
     T get() {
-        T best_item = elements.top().second;
+        T best_item = std::get<2>(elements.top());
         elements.pop();
         return best_item;
     }
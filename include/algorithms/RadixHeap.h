@@ -0,0 +1,146 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H 1
+
+#include <array>            /* std::array           */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint64_t        */
+#include <cstring>          /* std::memcpy          */
+#include <type_traits>      /* std::is_floating_point */
+#include <utility>          /* std::pair            */
+#include <vector>           /* std::vector          */
+
+/*
+ * Monotone radix heap, a drop-in replacement for PriorityQueue in Dijkstra
+ * and A* (with a consistent heuristic). Items are kept in 65 buckets by the
+ * highest bit in which their key differs from the last key taken out, so
+ * put() is O(1) and get() is O(1) amortized, with no comparisons between
+ * items.
+ *
+ * Keys must never be lower than the last one taken out. Slightly lower ones
+ * (rounding errors) are raised to it. Non-negative floating point priorities
+ * work too: their bit patterns sort like the values they represent.
+ *
+ * Items with the same priority come out last in, first out, which for A*
+ * approximates preferring the larger g. The tie argument is accepted only for
+ * interface compatibility.
+ */
+template<typename T, typename priority_t>
+class RadixHeap {
+public:
+    typedef std::uint64_t key_t;
+
+    RadixHeap() : last(0), count(0) {}
+
+    inline bool empty() const {
+        return count == 0;
+    }
+
+    inline std::size_t size() const {
+        return count;
+    }
+
+    std::size_t memoryUsage() const {
+        std::size_t bytes = 0;
+
+        for (const std::vector<Entry>& bucket : buckets)
+            bytes += bucket.capacity() * sizeof(Entry);
+
+        return bytes;
+    }
+
+    // Empties the queue. The grid size is only used by IndexedHeap
+    void reset(int rows, int columns) {
+        for (std::vector<Entry>& bucket : buckets)
+            bucket.clear();
+
+        last = 0;
+        count = 0;
+    }
+
+    inline void put(T item, priority_t priority, priority_t tie = priority_t()) {
+        key_t key = toKey(priority);
+
+        if (key < last)
+            key = last;
+
+        buckets[bucketFor(key)].emplace_back(key, item);
+        ++count;
+    }
+
+    T get() {
+        if (buckets[0].empty())
+            refill();
+
+        T best_item = buckets[0].back().second;
+        buckets[0].pop_back();
+        --count;
+
+        return best_item;
+    }
+
+private:
+    typedef std::pair<key_t, T> Entry;
+
+    key_t last;
+    std::size_t count;
+
+    std::array<std::vector<Entry>, 65> buckets;
+
+    static inline key_t toKey(const priority_t priority) {
+        if constexpr (std::is_floating_point<priority_t>::value) {
+            double value = priority > 0 ? (double) priority : 0.0;
+            key_t key;
+
+            std::memcpy(&key, &value, sizeof(key));
+            return key;
+        }
+        else {
+            return (key_t) priority;
+        }
+    }
+
+    inline std::size_t bucketFor(const key_t key) const {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+    // Moves the smallest keys into bucket 0
+    void refill() {
+        std::size_t i = 1;
+        while (buckets[i].empty())
+            ++i;
+
+        key_t smallest = buckets[i][0].first;
+        for (const Entry& entry : buckets[i]) {
+            if (entry.first < smallest)
+                smallest = entry.first;
+        }
+
+        last = smallest;
+
+        // Every entry of bucket i lands in a lower bucket now
+        for (Entry& entry : buckets[i])
+            buckets[bucketFor(entry.first)].push_back(entry);
+
+        buckets[i].clear();
+    }
+};
+
+#endif /* RADIXHEAP_H */
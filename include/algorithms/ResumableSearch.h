@@ -0,0 +1,186 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef RESUMABLE_SEARCH_H
+#define RESUMABLE_SEARCH_H  1
+
+#include <chrono>           /* std::chrono          */
+#include <cstddef>          /* std::size_t          */
+#include <limits>           /* std::numeric_limits  */
+
+#include "BestFirstSearch.h"
+
+// BestFirstSearch sink: passes every event on to sink, and closes each
+// expanded cell in workspace, which BFS does not do by itself
+template<typename Sink, typename Workspace>
+class ClosingSink {
+public:
+    ClosingSink(Workspace& workspace_, Sink sink_ = Sink())
+    : sink(sink_), workspace(&workspace_) {}
+
+    inline void started()
+    {
+        sink.started();
+    }
+
+    template<typename Location>
+    inline void popped(const Location& current)
+    {
+        sink.popped(current);
+    }
+
+    template<typename Location>
+    inline void stale(const Location& current)
+    {
+        sink.stale(current);
+    }
+
+    template<typename Location>
+    inline void expanded(const Location& current)
+    {
+        workspace->close(current);
+        sink.expanded(current);
+    }
+
+    template<typename Location, typename Frontier>
+    inline void pushed(const Location& next, const Frontier& frontier)
+    {
+        sink.pushed(next, frontier);
+    }
+
+    template<typename OtherWorkspace, typename Frontier>
+    inline void finished(
+        const OtherWorkspace& other_workspace, const Frontier& frontier
+    )
+    {
+        sink.finished(other_workspace, frontier);
+    }
+
+private:
+    Sink sink;
+    Workspace* workspace;
+};
+
+/*
+ * A best-first search run a few expansions at a time, to draw it as it goes
+ * or to spread one long query over several frames of a game loop:
+ *
+ *     ResumableSearch search(view, workspace, AStarSearch<Octile>());
+ *
+ *     while (!search.runFor(std::chrono::milliseconds(2)))
+ *         drawFrame(search);
+ *
+ * where drawFrame() asks isOpen() for the cells still queued, and
+ * workspace().closed() for the expanded ones.
+ *
+ * Engine is any BestFirstSearch (AStarSearch, DijkstraSearch,
+ * BreadthFirstSearch...), and between steps the workspace holds its
+ * came_from, cost so far and closed set. BFS closes nothing, so its
+ * visited cells are not enough to tell the queued ones apart: the search
+ * closes every expanded cell itself, BFS ones included, and the open set is
+ * the visited cells that are not closed. Graph and workspace are not
+ * copied, and must stay alive and unchanged until the search is over or
+ * restarted.
+ */
+template<typename Engine, typename Graph, typename Workspace>
+class ResumableSearch {
+public:
+    typedef typename Graph::location_t location_t;
+    typedef typename Engine::template FrontierType<
+        location_t, typename Workspace::cost_t
+    > frontier_t;
+
+    ResumableSearch(
+        const Graph& graph_, Workspace& workspace_, Engine engine_ = Engine()
+    )
+    : graph(graph_), search(workspace_),
+      engine(engine_.withSink(closing_sink_t(workspace_, engine_.sink)))
+    {
+        restart();
+    }
+
+    // Back to the start cell, e.g. once the graph changed
+    void restart()
+    {
+        engine.start(graph, search, queue);
+        over = false;
+        n_expanded = 0;
+    }
+
+    // Up to n expansions. True once the search is over
+    bool step(std::size_t n = 1)
+    {
+        std::size_t budget = n;
+
+        if (over)
+            return true;
+
+        over = engine.resume(graph, search, queue, budget);
+        n_expanded += n - budget;
+
+        return over;
+    }
+
+    // Steps of batch expansions until budget is spent, at least one
+    template<typename Rep, typename Period>
+    bool runFor(
+        const std::chrono::duration<Rep, Period>& budget,
+        std::size_t batch = 256
+    )
+    {
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+
+        while (!step(batch)) {
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+        }
+
+        return over;
+    }
+
+    // Whatever is left, in one go
+    bool run()
+    {
+        return step(std::numeric_limits<std::size_t>::max());
+    }
+
+    inline bool done() const { return over; }
+    inline std::size_t expanded() const { return n_expanded; }
+
+    // Queued and not expanded yet: a cell on the frontier. None once the
+    // search is over (JPS then fills its path in with visited cells)
+    inline bool isOpen(const location_t cell) const
+    {
+        return !over && search.visited(cell) && !search.closed(cell);
+    }
+
+    inline const Workspace& workspace() const { return search; }
+    inline const frontier_t& frontier() const { return queue; }
+private:
+    typedef ClosingSink<decltype(Engine::sink), Workspace> closing_sink_t;
+
+    const Graph& graph;
+    Workspace& search;
+    typename Engine::template WithSink<closing_sink_t> engine;
+    frontier_t queue;
+
+    bool over;
+    std::size_t n_expanded;
+};
+
+#endif /* RESUMABLE_SEARCH_H */
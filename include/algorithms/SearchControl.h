@@ -0,0 +1,143 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef SEARCH_CONTROL_H
+#define SEARCH_CONTROL_H    1
+
+#include <atomic>           /* std::atomic          */
+#include <cstddef>          /* std::size_t          */
+
+/*
+ * Shared between a search running on one thread and whoever watches it from
+ * another: a cancellation token the search checks once per expansion, and
+ * how many nodes it has expanded so far.
+ *
+ * Cancelling is cooperative. The search stops at its next expansion, as if
+ * the frontier had run out, and leaves a partial workspace behind.
+ */
+class SearchControl {
+public:
+    SearchControl() : cancel_requested(false), n_expanded(0) {}
+
+    SearchControl(const SearchControl&) = delete;
+    SearchControl& operator= (const SearchControl&) = delete;
+
+    inline void cancel()
+    {
+        cancel_requested.store(true, std::memory_order_relaxed);
+    }
+
+    inline bool cancelled() const
+    {
+        return cancel_requested.load(std::memory_order_relaxed);
+    }
+
+    inline std::size_t expanded() const
+    {
+        return n_expanded.load(std::memory_order_relaxed);
+    }
+
+    // Called by the search, e.g. through a ProgressSink
+    inline void reportExpanded(const std::size_t n)
+    {
+        n_expanded.store(n, std::memory_order_relaxed);
+    }
+
+    // Before reusing it for another search
+    void reset()
+    {
+        cancel_requested.store(false, std::memory_order_relaxed);
+        n_expanded.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> cancel_requested;
+    std::atomic<std::size_t> n_expanded;
+};
+
+// BestFirstSearch stop policy: stop's rule, or as soon as control is
+// cancelled
+template<typename Stop>
+struct Cancellable {
+    Stop stop;
+    const SearchControl* control;
+
+    explicit Cancellable(const SearchControl& control_, Stop stop_ = Stop())
+    : stop(stop_), control(&control_) {}
+
+    template<typename Location>
+    inline bool operator() (const Location& current, const Location& goal)
+        const
+    {
+        return stop(current, goal) || control->cancelled();
+    }
+};
+
+// BestFirstSearch sink: passes every event on to sink, and publishes the
+// number of expansions to control
+template<typename Sink>
+class ProgressSink {
+public:
+    ProgressSink(SearchControl& control_, Sink sink_ = Sink())
+    : sink(sink_), control(&control_), count(0) {}
+
+    inline void started()
+    {
+        count = 0;
+        control->reportExpanded(0);
+        sink.started();
+    }
+
+    template<typename Location>
+    inline void popped(const Location& current)
+    {
+        sink.popped(current);
+    }
+
+    template<typename Location>
+    inline void stale(const Location& current)
+    {
+        sink.stale(current);
+    }
+
+    template<typename Location>
+    inline void expanded(const Location& current)
+    {
+        control->reportExpanded(++count);
+        sink.expanded(current);
+    }
+
+    template<typename Location, typename Frontier>
+    inline void pushed(const Location& next, const Frontier& frontier)
+    {
+        sink.pushed(next, frontier);
+    }
+
+    template<typename Workspace, typename Frontier>
+    inline void finished(const Workspace& workspace, const Frontier& frontier)
+    {
+        sink.finished(workspace, frontier);
+    }
+
+private:
+    Sink sink;
+    SearchControl* control;
+    std::size_t count;
+};
+
+#endif /* SEARCH_CONTROL_H */
@@ -0,0 +1,122 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H  1
+
+#include <algorithm>        /* std::max             */
+#include <chrono>           /* std::chrono          */
+#include <cstddef>          /* std::size_t          */
+#include <ostream>          /* std::ostream         */
+
+// How much work one search did
+struct SearchStats {
+    std::size_t expanded = 0;
+    std::size_t pushes = 0;
+    std::size_t pops = 0;
+    // Stale frontier entries popped and skipped
+    std::size_t duplicate_pops = 0;
+    std::size_t peak_frontier = 0;
+    // Held by the workspace and frontier once the search is over. Neither
+    // gives memory back, so this is their peak
+    std::size_t bytes = 0;
+    double seconds = 0;
+};
+
+/*
+ * BestFirstSearch sink that fills in a SearchStats. Engines without it use
+ * NullSink, so they are not even timed. The workspace and frontier need
+ * memoryUsage(), as every one in this directory has.
+ */
+class StatsSink {
+public:
+    explicit StatsSink(SearchStats& stats_) : stats(&stats_) {}
+
+    inline void started()
+    {
+        *stats = SearchStats();
+        begin = Clock::now();
+    }
+
+    template<typename Location>
+    inline void popped(const Location&)
+    {
+        ++stats->pops;
+    }
+
+    template<typename Location>
+    inline void stale(const Location&)
+    {
+        ++stats->duplicate_pops;
+    }
+
+    template<typename Location>
+    inline void expanded(const Location&)
+    {
+        ++stats->expanded;
+    }
+
+    template<typename Location, typename Frontier>
+    inline void pushed(const Location&, const Frontier& frontier)
+    {
+        ++stats->pushes;
+        stats->peak_frontier = std::max(stats->peak_frontier,
+            frontier.size());
+    }
+
+    template<typename Workspace, typename Frontier>
+    inline void finished(const Workspace& workspace, const Frontier& frontier)
+    {
+        stats->bytes = workspace.memoryUsage() + frontier.memoryUsage();
+        stats->seconds = std::chrono::duration<double>(Clock::now() - begin)
+            .count();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    SearchStats* stats;
+    Clock::time_point begin;
+};
+
+// Column names for search_stats_csv(), comma separated
+inline void search_stats_csv_header(std::ostream& out)
+{
+    out << "expanded,pushes,pops,duplicate_pops,peak_frontier,bytes,seconds";
+}
+
+inline void search_stats_csv(std::ostream& out, const SearchStats& stats)
+{
+    out << stats.expanded << ',' << stats.pushes << ',' << stats.pops << ','
+        << stats.duplicate_pops << ',' << stats.peak_frontier << ','
+        << stats.bytes << ',' << stats.seconds;
+}
+
+// The members of a JSON object, without the braces around them
+inline void search_stats_json(std::ostream& out, const SearchStats& stats)
+{
+    out << "\"expanded\": " << stats.expanded
+        << ", \"pushes\": " << stats.pushes
+        << ", \"pops\": " << stats.pops
+        << ", \"duplicate_pops\": " << stats.duplicate_pops
+        << ", \"peak_frontier\": " << stats.peak_frontier
+        << ", \"bytes\": " << stats.bytes
+        << ", \"seconds\": " << stats.seconds;
+}
+
+#endif /* SEARCH_STATS_H */
@@ -0,0 +1,174 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H  1
+
+#include <algorithm>        /* std::fill            */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint32_t        */
+#include <limits>           /* std::numeric_limits  */
+#include <vector>           /* std::vector          */
+
+/*
+ * came_from and cost_so_far for every cell of a rows x columns grid, stored
+ * in dense arrays indexed by y * columns + x.
+ *
+ * A cell only holds valid data if its stamp belongs to the current epoch, so
+ * reset() just moves to a new epoch instead of clearing the arrays. Keep one
+ * workspace around and reuse it between searches. Each epoch takes two stamp
+ * values: epoch for visited cells and epoch + 1 for closed (expanded) ones.
+ *
+ * Positions must always be inside the grid.
+ */
+template<typename Location, typename CostType>
+class SearchWorkspace {
+public:
+    typedef Location location_t;
+    typedef CostType cost_t;
+
+    SearchWorkspace() : SearchWorkspace(0, 0) {}
+
+    SearchWorkspace(int rows_, int columns_)
+    : rows(0), columns(0), epoch(2), count(0)
+    {
+        resize(rows_, columns_);
+    }
+
+    // Reallocates (and clears) only if the size changed
+    void resize(int rows_, int columns_)
+    {
+        if (rows_ == rows && columns_ == columns)
+            return;
+
+        rows = rows_;
+        columns = columns_;
+
+        std::size_t area = (std::size_t) rows * columns;
+
+        stamps.assign(area, 0);
+        came_from.resize(area);
+        cost_so_far.resize(area);
+
+        epoch = 2;
+        count = 0;
+    }
+
+    // Forgets every visited cell in O(1)
+    void reset()
+    {
+        count = 0;
+
+        if (epoch >= std::numeric_limits<epoch_t>::max() - 3) {
+            // About to wrap around: stale stamps could match again
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 0;
+        }
+
+        epoch += 2;
+    }
+
+    inline bool visited(const Location position) const
+    {
+        return stamps[index(position)] >= epoch;
+    }
+
+    inline bool closed(const Location position) const
+    {
+        return stamps[index(position)] == epoch + 1;
+    }
+
+    // Marks a visited cell as expanded. visit() opens it again
+    inline void close(const Location position)
+    {
+        stamps[index(position)] = epoch + 1;
+    }
+
+    inline const Location& cameFrom(const Location position) const
+    {
+        return came_from[index(position)];
+    }
+
+    inline CostType costSoFar(const Location position) const
+    {
+        return cost_so_far[index(position)];
+    }
+
+    inline void visit(
+        const Location position, const Location from, const CostType cost
+    )
+    {
+        std::size_t i = index(position);
+
+        if (stamps[i] < epoch)
+            ++count;
+
+        stamps[i] = epoch;
+
+        came_from[i] = from;
+        cost_so_far[i] = cost;
+    }
+
+    // Number of cells visited since the last reset()
+    inline std::size_t size() const
+    {
+        return count;
+    }
+
+    inline bool empty() const
+    {
+        return count == 0;
+    }
+
+    // Bytes held by the arrays, which only grow
+    std::size_t memoryUsage() const
+    {
+        return stamps.capacity() * sizeof(epoch_t)
+            + came_from.capacity() * sizeof(Location)
+            + cost_so_far.capacity() * sizeof(CostType);
+    }
+
+    int getRows() const
+    {
+        return rows;
+    }
+
+    int getColumns() const
+    {
+        return columns;
+    }
+
+private:
+    typedef std::uint32_t epoch_t;
+
+    int rows, columns;
+
+    epoch_t epoch;
+    std::size_t count;
+
+    std::vector<epoch_t> stamps;
+    std::vector<Location> came_from;
+    std::vector<CostType> cost_so_far;
+
+    inline std::size_t index(const Location position) const
+    {
+        return (std::size_t) position.y * columns + position.x;
+    }
+};
+
+#endif /* SEARCH_WORKSPACE_H */
@@ -0,0 +1,143 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef SPARSE_WORKSPACE_H
+#define SPARSE_WORKSPACE_H  1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint32_t, std::uint64_t */
+#include <unordered_map>    /* std::unordered_map   */
+
+/*
+ * Same interface as SearchWorkspace, but only the cells a search visits take
+ * memory, so boards too large for dense per-cell arrays (e.g. a ChunkedBoard)
+ * can still be searched. Slower per cell: use SearchWorkspace when the grid
+ * fits in memory.
+ */
+template<typename Location, typename CostType>
+class SparseWorkspace {
+public:
+    typedef Location location_t;
+    typedef CostType cost_t;
+
+    SparseWorkspace() : rows(0), columns(0) {}
+
+    SparseWorkspace(int rows_, int columns_)
+    : rows(rows_), columns(columns_) {}
+
+    // Nothing to allocate
+    void resize(int rows_, int columns_)
+    {
+        rows = rows_;
+        columns = columns_;
+    }
+
+    // Keeps the buckets, so the next search does not grow the table again
+    void reset()
+    {
+        cells.clear();
+    }
+
+    inline bool visited(const Location position) const
+    {
+        return cells.find(position) != cells.end();
+    }
+
+    inline bool closed(const Location position) const
+    {
+        auto found = cells.find(position);
+
+        return found != cells.end() && found->second.closed;
+    }
+
+    // Marks a visited cell as expanded. visit() opens it again
+    inline void close(const Location position)
+    {
+        cells[position].closed = true;
+    }
+
+    inline const Location& cameFrom(const Location position) const
+    {
+        return cells.at(position).came_from;
+    }
+
+    inline CostType costSoFar(const Location position) const
+    {
+        return cells.at(position).cost_so_far;
+    }
+
+    inline void visit(
+        const Location position, const Location from, const CostType cost
+    )
+    {
+        cells[position] = {from, cost, false};
+    }
+
+    // Number of cells visited since the last reset()
+    inline std::size_t size() const
+    {
+        return cells.size();
+    }
+
+    inline bool empty() const
+    {
+        return cells.empty();
+    }
+
+    // Roughly: one node per cell plus the bucket array
+    std::size_t memoryUsage() const
+    {
+        return cells.size() * (sizeof(Location) + sizeof(Cell) + sizeof(void*))
+            + cells.bucket_count() * sizeof(void*);
+    }
+
+    int getRows() const
+    {
+        return rows;
+    }
+
+    int getColumns() const
+    {
+        return columns;
+    }
+
+private:
+    struct Cell {
+        Location came_from;
+        CostType cost_so_far;
+        bool closed;
+    };
+
+    // std::hash<graph::Location> squares coordinates, which overflows on
+    // the boards this is meant for
+    struct Hash {
+        inline std::size_t operator() (const Location position) const
+        {
+            std::uint64_t key = ((std::uint64_t) (std::uint32_t) position.y
+                << 32) | (std::uint32_t) position.x;
+
+            return (std::size_t) ((key * 0x9e3779b97f4a7c15ull) >> 16);
+        }
+    };
+
+    int rows, columns;
+
+    std::unordered_map<Location, Cell, Hash> cells;
+};
+
+#endif /* SPARSE_WORKSPACE_H */
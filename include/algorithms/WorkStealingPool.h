@@ -0,0 +1,214 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H    1
+
+#include <condition_variable>   /* std::condition_variable */
+#include <cstddef>          /* std::size_t          */
+#include <functional>       /* std::function        */
+#include <memory>           /* std::unique_ptr      */
+#include <mutex>            /* std::mutex, std::unique_lock */
+#include <thread>           /* std::thread          */
+#include <vector>           /* std::vector          */
+
+/*
+ * A fixed set of threads that run tasks 0 ... n - 1 of one job at a time.
+ *
+ * Each worker starts with an even, contiguous share of the tasks and takes
+ * them from the front. One that runs out steals the back half of what is
+ * left to another worker, so a share full of long searches gets spread over
+ * the idle ones instead of holding up the whole job.
+ *
+ * The thread calling run() is worker 0, so a pool of n workers starts n - 1
+ * threads. Tasks must not throw.
+ */
+class WorkStealingPool {
+public:
+    typedef std::function<void(unsigned, std::size_t)> task_t;
+
+    // 0 workers means one per hardware thread
+    explicit WorkStealingPool(unsigned workers = 0)
+    {
+        if (workers == 0)
+            workers = std::thread::hardware_concurrency();
+
+        if (workers == 0)
+            workers = 1;
+
+        for (unsigned i = 0; i < workers; ++i)
+            shares.emplace_back(new Share());
+
+        for (unsigned i = 1; i < workers; ++i)
+            threads.emplace_back(&WorkStealingPool::loop, this, i);
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+
+        wake.notify_all();
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator= (const WorkStealingPool&) = delete;
+
+    unsigned size() const
+    {
+        return (unsigned) shares.size();
+    }
+
+    // Calls task(worker, i) once for each i < n_tasks and returns when all
+    // of them are done. A worker only ever runs one task at a time
+    void run(const std::size_t n_tasks, task_t task_)
+    {
+        std::size_t n = shares.size();
+
+        for (std::size_t w = 0; w < n; ++w) {
+            shares[w]->begin = n_tasks * w / n;
+            shares[w]->end = n_tasks * (w + 1) / n;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            task = std::move(task_);
+            busy = (unsigned) n - 1;
+            ++job;
+        }
+
+        wake.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this] { return busy == 0; });
+
+        task = nullptr;
+    }
+
+private:
+    // Tasks [begin, end) not started yet
+    struct Share {
+        std::mutex lock;
+        std::size_t begin = 0, end = 0;
+    };
+
+    std::vector<std::unique_ptr<Share>> shares;
+    std::vector<std::thread> threads;
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    task_t task;
+    // Bumped once per run(), so a worker knows a job is new
+    std::size_t job = 0;
+    // Workers other than 0 still in the current job
+    unsigned busy = 0;
+    bool stopping = false;
+
+    void loop(const unsigned worker)
+    {
+        std::size_t seen = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || job != seen; });
+
+                if (stopping)
+                    return;
+
+                seen = job;
+            }
+
+            work(worker);
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+
+                if (--busy == 0)
+                    done.notify_one();
+            }
+        }
+    }
+
+    void work(const unsigned worker)
+    {
+        std::size_t i;
+
+        while (take(worker, i) || steal(worker, i))
+            task(worker, i);
+    }
+
+    bool take(const unsigned worker, std::size_t& i)
+    {
+        Share& own = *shares[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+
+        if (own.begin == own.end)
+            return false;
+
+        i = own.begin++;
+
+        return true;
+    }
+
+    // Moves the back half of another worker's share into this one's, and
+    // takes its first task
+    bool steal(const unsigned worker, std::size_t& i)
+    {
+        std::size_t n = shares.size();
+
+        for (std::size_t k = 1; k < n; ++k) {
+            Share& victim = *shares[(worker + k) % n];
+            std::size_t begin, end;
+
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+
+                if (victim.begin == victim.end)
+                    continue;
+
+                end = victim.end;
+                begin = victim.begin + (end - victim.begin) / 2;
+                victim.end = begin;
+            }
+
+            Share& own = *shares[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+
+            i = begin;
+            own.begin = begin + 1;
+            own.end = end;
+
+            return true;
+        }
+
+        return false;
+    }
+};
+
+#endif /* WORK_STEALING_POOL_H */
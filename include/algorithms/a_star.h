@@ -19,63 +19,93 @@
 #ifndef ASTAR_H
 #define ASTAR_H     1
 
-#include <algorithm>        /* std::reverse         */
-#include <queue>            /* std::priority_queue  */
-#include <unordered_map>    /* std::unordered_map   */
+#include <cmath>            /* std::round           */
+#include <type_traits>      /* std::is_floating_point */
 
+#include "BestFirstSearch.h"
+#include "heuristics.h"
+#include "IndexedHeap.h"
 #include "PriorityQueue.h"
+#include "SearchWorkspace.h"
 
-template<typename Graph, typename CostType>
+/*
+ * Costs made of sqrt(2) steps pick up rounding errors, so two f values that
+ * are equal on paper rarely compare equal and the tie-breaking never kicks
+ * in. Snapping f to a 2^-20 grid turns them back into ties.
+ */
+template<typename CostType>
+inline CostType
+a_star_snap(const CostType f)
+{
+    if constexpr (std::is_floating_point<CostType>::value)
+        return std::round(f * 1048576) / 1048576;
+    else
+        return f;
+}
+
+/*
+ * f = g + heuristic(location, goal), snapped. heuristic is any callable
+ * taking (location, goal) and returning an estimate of the remaining cost,
+ * see heuristics.h.
+ */
+template<typename Heuristic>
+struct HeuristicPriority {
+    Heuristic heuristic;
+
+    explicit HeuristicPriority(Heuristic heuristic_ = Heuristic())
+    : heuristic(heuristic_) {}
+
+    template<typename CostType, typename Location>
+    inline CostType operator() (
+        const CostType cost, const Location& next, const Location& goal
+    ) const
+    {
+        return a_star_snap(cost + heuristic(next, goal));
+    }
+};
+
+template<typename Heuristic>
+using AStarSearch = BestFirstSearch<HeuristicPriority<Heuristic>>;
+
+/*
+ * Ties on f are broken in favour of the larger cost so far.
+ *
+ * frontier is any of PriorityQueue, IndexedHeap, or RadixHeap / BucketQueue
+ * for consistent heuristics. Passing one in lets it be reused between
+ * searches. Expanded nodes are closed, so stale frontier entries left behind
+ * by queues without decrease-key are skipped instead of expanded again. The
+ * heuristic must be consistent: closed nodes are never reopened.
+ */
+template<typename Graph, typename Workspace, typename Heuristic,
+    typename Frontier>
 void
 a_star_search (
     const Graph& graph, 
-    std::unordered_map<typename Graph::location_t, typename Graph::location_t>& came_from,
-    std::unordered_map<typename Graph::location_t, CostType>& cost_so_far,
-    CostType (*heuristic) (
-        const typename Graph::location_t a,
-        const typename Graph::location_t b
-    )
+    Workspace& workspace,
+    Heuristic heuristic,
+    Frontier& frontier
 )
 {
-    typedef typename Graph::location_t Location;
-
-    const Location& start = graph.getStart();
-    const Location& goal = graph.getGoal();
-    Location current = {};
-
-
-    PriorityQueue<Location, CostType> frontier;
-    frontier.put(start, 0);
-
-
-    came_from[start] = start;
-    cost_so_far[start] = 0;
-
-
-    CostType new_cost, priority;
-
-    while (!frontier.empty()) {
-        current = frontier.get();
-        
-        // Early exit
-        if (current == goal)
-            break;
-
-        for (Location next: graph.neighbors(current)) {
-            new_cost = cost_so_far[current] + graph.cost(current, next);
-
-            if (came_from.find(next) == came_from.end() 
-                || new_cost < cost_so_far[next])
-            {
-                cost_so_far[next] = new_cost;
-                came_from[next] = current;
+    AStarSearch<Heuristic>(HeuristicPriority<Heuristic>(heuristic))(
+        graph, workspace, frontier
+    );
+}
 
-                priority = new_cost + heuristic(next, goal);
+// Same, with a fresh Queue, e.g. a_star_search<RadixHeap>(graph, ws, h)
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace, typename Heuristic
+>
+void
+a_star_search (
+    const Graph& graph, 
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    Queue<typename Graph::location_t, typename Workspace::cost_t> frontier;
 
-                frontier.put(next, priority);
-            }
-        }
-    }
+    a_star_search(graph, workspace, heuristic, frontier);
 }
 
 #endif /* ASTAR_H */
\ No newline at end of file
@@ -19,43 +19,23 @@
 #ifndef BFS_H
 #define BFS_H   1
 
-#include <queue>            /* std::queue           */
-#include <unordered_map>    /* std::unordered_map   */
+#include "BestFirstSearch.h"
+#include "FifoQueue.h"
+#include "SearchWorkspace.h"
 
-template<typename Graph>
+typedef BestFirstSearch<
+    CostPriority, FifoQueue, UnitNeighbors, FirstVisitFinal
+> BreadthFirstSearch;
+
+// Stores the number of steps from start as each cell's cost
+template<typename Graph, typename Workspace>
 void
 breadth_first_search(
     const Graph& graph,
-    std::unordered_map<typename Graph::location_t, typename Graph::location_t>& came_from
+    Workspace& workspace
 )
 {
-    typedef typename Graph::location_t Location;
-
-    const Location& start = graph.getStart();
-    const Location& goal = graph.getGoal();
-    Location current = {};
-
-    std::queue<Location> frontier;
-    frontier.push(start);
-
-    came_from[start] = start;
-
-    while (!frontier.empty()) {
-        current = frontier.front();
-        frontier.pop();
-
-        // Early exit
-        if (current == goal)
-            break;
-
-
-        for (Location next: graph.neighbors(current)) {
-            if (came_from.find(next) == came_from.end()) {
-                frontier.push(next);
-                came_from[next] = current;
-            }
-        }
-    }
+    BreadthFirstSearch()(graph, workspace);
 }
 
 #endif /* BFS_H */
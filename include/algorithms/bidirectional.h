@@ -0,0 +1,248 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BIDIRECTIONAL_H
+#define BIDIRECTIONAL_H 1
+
+#include <limits>           /* std::numeric_limits  */
+#include <type_traits>      /* std::is_floating_point */
+
+#include "a_star.h"         /* a_star_snap          */
+#include "heuristics.h"     /* ZeroHeuristic        */
+#include "PriorityQueue.h"
+#include "SearchWorkspace.h"
+
+/*
+ * Bidirectional A*: one search grows from the start and another one from the
+ * goal until they meet.
+ *
+ * The backward search walks edges the other way round. Every movement policy
+ * is symmetric, so the cells before v are neighbors(v), but the cost of
+ * u -> v is still graph.cost(u, v): it is charged on the destination cell,
+ * so backward costs are not the forward ones mirrored.
+ *
+ * Both sides use the average potential p(v) = (h(v, goal) - h(v, start)) / 2,
+ * forward keys g(v) + p(v) and backward keys g'(v) - p(v). That keeps both
+ * of them consistent, and the search can stop as soon as the two smallest
+ * keys add up to the best path found so far (mu). With a ZeroHeuristic it
+ * is plain bidirectional Dijkstra.
+ *
+ * workspace ends up holding the whole path: the backward half is copied into
+ * it when the search stops, so search_reconstruct_path() works as usual.
+ * backward keeps the cost to the goal of every cell the second search saw.
+ *
+ * frontier and backward_frontier need topPriority(): PriorityQueue or
+ * IndexedHeap.
+ */
+template<typename Graph, typename Workspace, typename Heuristic,
+    typename Frontier>
+void
+bidirectional_a_star_search(
+    const Graph& graph,
+    Workspace& workspace,
+    Workspace& backward,
+    Heuristic heuristic,
+    Frontier& frontier,
+    Frontier& backward_frontier
+)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Workspace::cost_t CostType;
+
+    const Location& start = graph.getStart();
+    const Location& goal = graph.getGoal();
+    Location current = {};
+
+
+    auto potential = [&](const Location position) {
+        return (heuristic(position, goal) - heuristic(position, start)) / 2;
+    };
+
+    // Keys are snapped like a_star_search's f, so their sum only matches mu
+    // to within the snapping grid. Demanding more would expand the whole f
+    // plateau in open areas
+    const CostType tolerance = std::is_floating_point<CostType>::value
+        ? (CostType) 1 / 1048576 : 0;
+
+
+    frontier.reset(graph.getRows(), graph.getColumns());
+    frontier.put(start, a_star_snap(potential(start)));
+
+    backward_frontier.reset(graph.getRows(), graph.getColumns());
+    backward_frontier.put(goal, a_star_snap(-potential(goal)));
+
+
+    workspace.resize(graph.getRows(), graph.getColumns());
+    workspace.reset();
+    workspace.visit(start, start, 0);
+
+    backward.resize(graph.getRows(), graph.getColumns());
+    backward.reset();
+    backward.visit(goal, goal, 0);
+
+
+    // Best path so far goes start ~> meet_from -> meet_to ~> goal
+    CostType mu = std::numeric_limits<CostType>::max();
+    Location meet_from = start, meet_to = start;
+
+    CostType new_cost, priority;
+
+    if (start == goal)
+        return;
+
+    while (!frontier.empty() && !backward_frontier.empty()) {
+        if (mu != std::numeric_limits<CostType>::max()
+            && frontier.topPriority() + backward_frontier.topPriority()
+                >= mu - tolerance)
+        {
+            break;
+        }
+
+        if (frontier.size() <= backward_frontier.size()) {
+            current = frontier.get();
+
+            // Stale copy of a node that was already expanded
+            if (workspace.closed(current))
+                continue;
+
+            workspace.close(current);
+
+            for (Location next: graph.neighbors(current)) {
+                new_cost = workspace.costSoFar(current)
+                    + graph.cost(current, next);
+
+                if (backward.visited(next)
+                    && new_cost + backward.costSoFar(next) < mu)
+                {
+                    mu = new_cost + backward.costSoFar(next);
+                    meet_from = current;
+                    meet_to = next;
+                }
+
+                // Its cost is final. Rounding noise must not reopen it
+                if (workspace.closed(next))
+                    continue;
+
+                if (!workspace.visited(next)
+                    || new_cost < workspace.costSoFar(next))
+                {
+                    workspace.visit(next, current, new_cost);
+
+                    priority = a_star_snap(new_cost + potential(next));
+
+                    frontier.put(next, priority, new_cost);
+                }
+            }
+        }
+        else {
+            current = backward_frontier.get();
+
+            if (backward.closed(current))
+                continue;
+
+            backward.close(current);
+
+            // Cells that can step into current
+            for (Location previous: graph.neighbors(current)) {
+                new_cost = backward.costSoFar(current)
+                    + graph.cost(previous, current);
+
+                if (workspace.visited(previous)
+                    && workspace.costSoFar(previous) + new_cost < mu)
+                {
+                    mu = workspace.costSoFar(previous) + new_cost;
+                    meet_from = previous;
+                    meet_to = current;
+                }
+
+                if (backward.closed(previous))
+                    continue;
+
+                if (!backward.visited(previous)
+                    || new_cost < backward.costSoFar(previous))
+                {
+                    backward.visit(previous, current, new_cost);
+
+                    priority = a_star_snap(new_cost - potential(previous));
+
+                    backward_frontier.put(previous, priority, new_cost);
+                }
+            }
+        }
+    }
+
+    if (mu == std::numeric_limits<CostType>::max())
+        return;
+
+    // Splice the backward half onto the forward tree. Costs are recomputed
+    // from meet_from, whose cost may have improved since the meeting
+    Location from = meet_from;
+    current = meet_to;
+    new_cost = workspace.costSoFar(meet_from);
+
+    while (true) {
+        new_cost += graph.cost(from, current);
+        workspace.visit(current, from, new_cost);
+
+        if (current == goal)
+            break;
+
+        from = current;
+        current = backward.cameFrom(current);
+    }
+}
+
+// Same, with fresh Queues, e.g. bidirectional_a_star_search(g, ws, bw, h)
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace, typename Heuristic
+>
+void
+bidirectional_a_star_search(
+    const Graph& graph,
+    Workspace& workspace,
+    Workspace& backward,
+    Heuristic heuristic
+)
+{
+    Queue<typename Graph::location_t, typename Workspace::cost_t> frontier;
+    Queue<typename Graph::location_t, typename Workspace::cost_t> reverse;
+
+    bidirectional_a_star_search(
+        graph, workspace, backward, heuristic, frontier, reverse
+    );
+}
+
+// Bidirectional Dijkstra: bidirectional A* without a heuristic
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace
+>
+void
+bidirectional_dijkstra_search(
+    const Graph& graph,
+    Workspace& workspace,
+    Workspace& backward
+)
+{
+    bidirectional_a_star_search<Queue>(
+        graph, workspace, backward, ZeroHeuristic()
+    );
+}
+
+#endif /* BIDIRECTIONAL_H */
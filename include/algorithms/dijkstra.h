@@ -19,55 +19,44 @@
 #ifndef DIJKSTRA_H
 #define DIJKSTRA_H  1
 
-#include <algorithm>        /* std::reverse         */
-#include <queue>            /* std::priority_queue  */
-#include <unordered_map>    /* std::unordered_map   */
-
+#include "BestFirstSearch.h"
+#include "IndexedHeap.h"
 #include "PriorityQueue.h"
+#include "SearchWorkspace.h"
+
+typedef BestFirstSearch<CostPriority> DijkstraSearch;
 
-template<typename Graph, typename CostType>
+/*
+ * frontier is any of PriorityQueue, IndexedHeap, RadixHeap, or BucketQueue
+ * when every cost is a whole number. Passing one in lets it be reused between
+ * searches. Expanded nodes are closed, so stale frontier entries left behind
+ * by queues without decrease-key are skipped instead of expanded again.
+ */
+template<typename Graph, typename Workspace, typename Frontier>
 void
 dijkstra_search (
     const Graph& graph, 
-    std::unordered_map<typename Graph::location_t, typename Graph::location_t>& came_from,
-    std::unordered_map<typename Graph::location_t, CostType>& cost_so_far
+    Workspace& workspace,
+    Frontier& frontier
 )
 {
-    typedef typename Graph::location_t Location;
-
-    const Location& start = graph.getStart();
-    const Location& goal = graph.getGoal();
-    Location current = {};
-
-
-    PriorityQueue<Location, CostType> frontier;
-    frontier.put(start, 0);
-
-    came_from[start] = start;
-    cost_so_far[start] = 0;
-
-
-    CostType new_cost;
-
-    while (!frontier.empty()) {
-        current = frontier.get();
-        
-        // Early exit
-        if (current == goal)
-            break;
+    DijkstraSearch()(graph, workspace, frontier);
+}
 
-        for (Location next: graph.neighbors(current)) {
-            new_cost = cost_so_far[current] + graph.cost(current, next);
+// Same, with a fresh Queue, e.g. dijkstra_search<BucketQueue>(graph, ws)
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace
+>
+void
+dijkstra_search (
+    const Graph& graph, 
+    Workspace& workspace
+)
+{
+    Queue<typename Graph::location_t, typename Workspace::cost_t> frontier;
 
-            if (came_from.find(next) == came_from.end() 
-                || new_cost < cost_so_far[next])
-            {
-                cost_so_far[next] = new_cost;
-                came_from[next] = current;
-                frontier.put(next, new_cost);
-            }
-        }
-    }
+    dijkstra_search(graph, workspace, frontier);
 }
 
 #endif /* DIJKSTRA_H */
\ No newline at end of file
@@ -0,0 +1,121 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef HEURISTICS_H
+#define HEURISTICS_H    1
+
+#include <algorithm>        /* std::min, std::max   */
+#include <cmath>            /* std::sqrt            */
+#include <cstdlib>          /* std::abs             */
+#include <type_traits>      /* std::conditional     */
+
+/*
+ * Heuristic functors for a_star_search. Being plain structs with an inline
+ * operator(), the compiler can inline them into the search loop (a function
+ * pointer usually cannot be).
+ *
+ * All of them are admissible and consistent as long as min_cost is not above
+ * the cheapest cost a single straight step can have on the graph.
+ */
+
+// Distance when only straight moves are allowed (4-way)
+struct Manhattan {
+    double min_cost;
+
+    explicit Manhattan(double min_cost_ = 1) : min_cost(min_cost_) {}
+
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        return min_cost * (std::abs(a.x - b.x) + std::abs(a.y - b.y));
+    }
+};
+
+/*
+ * Distance on an 8-way grid where straight steps cost D and diagonal steps
+ * cost D2. With D2 = sqrt(2) * D (graph::Board) this is the exact distance on
+ * open ground, the tightest admissible bound there is.
+ */
+struct Octile {
+    double straight;
+    double diagonal;
+
+    explicit Octile(double min_cost_ = 1)
+    : straight(min_cost_), diagonal(min_cost_ * std::sqrt(2.0)) {}
+
+    Octile(double straight_, double diagonal_)
+    : straight(straight_), diagonal(diagonal_) {}
+
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        int dx = std::abs(a.x - b.x);
+        int dy = std::abs(a.y - b.y);
+
+        return straight * std::max(dx, dy)
+            + (diagonal - straight) * std::min(dx, dy);
+    }
+};
+
+// Octile distance when a diagonal step costs the same as a straight one
+struct Chebyshev {
+    double min_cost;
+
+    explicit Chebyshev(double min_cost_ = 1) : min_cost(min_cost_) {}
+
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        return min_cost * std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+    }
+};
+
+// Straight line distance. Admissible for every movement, but the weakest
+struct Euclidean {
+    double min_cost;
+
+    explicit Euclidean(double min_cost_ = 1) : min_cost(min_cost_) {}
+
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        double dx = a.x - b.x;
+        double dy = a.y - b.y;
+
+        return min_cost * std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+// A* with this heuristic behaves exactly like Dijkstra
+struct ZeroHeuristic {
+    template<typename Location>
+    inline double operator() (const Location a, const Location b) const
+    {
+        return 0;
+    }
+};
+
+// Best heuristic for a movement policy (see graph/Movement.h)
+template<typename Movement>
+struct MatchedHeuristic {
+    typedef typename std::conditional<
+        Movement::diagonals, Octile, Manhattan
+    >::type type;
+};
+
+#endif /* HEURISTICS_H */
@@ -0,0 +1,253 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef HPA_STAR_H
+#define HPA_STAR_H  1
+
+#include <cstddef>          /* std::size_t          */
+#include <vector>           /* std::vector          */
+
+#include "../graph/ClusterView.h"   /* graph::ClusterView */
+
+#include "a_star.h"
+#include "dijkstra.h"
+#include "HpaGraph.h"
+#include "search_algorithm.h"       /* search_reconstruct_path */
+
+/*
+ * An HpaGraph plus a query's start and goal, seen as a graph a_star_search
+ * can walk. The start links to the nodes of its cluster and the nodes of the
+ * goal's cluster link to the goal, with the costs of a search inside each
+ * cluster.
+ */
+template<typename Movement>
+class HpaQueryView {
+public:
+    typedef graph::Location location_t;
+    typedef typename HpaGraph<Movement>::cost_t cost_t;
+    typedef typename HpaGraph<Movement>::Cluster Cluster;
+
+    HpaQueryView(
+        const HpaGraph<Movement>& hpa_,
+        const location_t start_, const location_t goal_
+    )
+    : hpa(hpa_), start(start_), goal(goal_),
+      start_cluster(hpa_.clusterOf(start_)),
+      goal_cluster(hpa_.clusterOf(goal_)),
+      start_to_goal(HpaGraph<Movement>::unreachable) {}
+
+    // Costs inside the start and goal clusters, from a flood of each one
+    template<typename Workspace>
+    void connect(Workspace& workspace)
+    {
+        const Cluster& from = hpa.cluster(start_cluster);
+        const Cluster& to = hpa.cluster(goal_cluster);
+
+        graph::ClusterView<Movement> forward(
+            hpa.getBoard(), from.area, start, {-1, -1}
+        );
+        dijkstra_search(forward, workspace);
+
+        from_start.assign(from.nodes.size(), HpaGraph<Movement>::unreachable);
+
+        for (std::size_t i = 0; i < from.nodes.size(); ++i)
+            if (workspace.visited(from.nodes[i]))
+                from_start[i] = workspace.costSoFar(from.nodes[i]);
+
+        if (start_cluster == goal_cluster && workspace.visited(goal))
+            start_to_goal = workspace.costSoFar(goal);
+
+        // Reversed, so costs are still charged on the cell being entered
+        graph::ClusterView<Movement> backward(
+            hpa.getBoard(), to.area, goal, {-1, -1}, true
+        );
+        dijkstra_search(backward, workspace);
+
+        to_goal.assign(to.nodes.size(), HpaGraph<Movement>::unreachable);
+
+        for (std::size_t i = 0; i < to.nodes.size(); ++i)
+            if (workspace.visited(to.nodes[i]))
+                to_goal[i] = workspace.costSoFar(to.nodes[i]);
+    }
+
+    const std::vector<location_t>& neighbors(const location_t position) const
+    {
+        const Cluster& owner = hpa.cluster(hpa.clusterOf(position));
+        int node = hpa.nodeIndex(position);
+
+        scratch.clear();
+
+        if (position == start) {
+            for (std::size_t i = 0; i < from_start.size(); ++i)
+                if (from_start[i] != HpaGraph<Movement>::unreachable)
+                    scratch.push_back(owner.nodes[i]);
+
+            if (start_to_goal != HpaGraph<Movement>::unreachable)
+                scratch.push_back(goal);
+        }
+        else if (node >= 0) {
+            std::size_t n = owner.nodes.size();
+
+            for (std::size_t j = 0; j < n; ++j)
+                if (owner.distances[node * n + j]
+                    != HpaGraph<Movement>::unreachable)
+                {
+                    scratch.push_back(owner.nodes[j]);
+                }
+
+            if (hpa.clusterOf(position) == goal_cluster
+                && to_goal[node] != HpaGraph<Movement>::unreachable)
+            {
+                scratch.push_back(goal);
+            }
+        }
+
+        if (node >= 0) {
+            for (const auto& link : owner.links)
+                if (link.first == node)
+                    scratch.push_back(link.second);
+        }
+
+        return scratch;
+    }
+
+    cost_t cost(const location_t from, const location_t to) const
+    {
+        int id = hpa.clusterOf(from);
+        const Cluster& owner = hpa.cluster(id);
+
+        // Across a border
+        if (hpa.clusterOf(to) != id)
+            return hpa.getBoard().cost(from, to);
+
+        if (from == start)
+            return (to == goal)
+                ? start_to_goal : from_start[hpa.nodeIndex(to)];
+
+        if (to == goal)
+            return to_goal[hpa.nodeIndex(from)];
+
+        std::size_t n = owner.nodes.size();
+
+        return owner.distances[
+            hpa.nodeIndex(from) * n + hpa.nodeIndex(to)
+        ];
+    }
+
+    int getRows() const { return hpa.getBoard().getRows(); }
+    int getColumns() const { return hpa.getBoard().getColumns(); }
+
+    const location_t& getStart() const { return start; }
+    const location_t& getGoal() const { return goal; }
+
+private:
+    const HpaGraph<Movement>& hpa;
+
+    location_t start;
+    location_t goal;
+
+    int start_cluster, goal_cluster;
+
+    // Aligned with the nodes of the start and goal clusters
+    std::vector<cost_t> from_start;
+    std::vector<cost_t> to_goal;
+    cost_t start_to_goal;
+
+    mutable std::vector<location_t> scratch;
+};
+
+/*
+ * HPA*: an abstract path through the HpaGraph first, then a_star_search
+ * inside each cluster it crosses to fill in the cells. Paths are close to,
+ * but not always, the cheapest ones.
+ *
+ * hpa must be built for the graph's board and movement policy. Clusters
+ * edited since the last query are rebuilt first. On return, workspace only
+ * holds the path, ready for search_reconstruct_path().
+ */
+template<typename Graph, typename Workspace, typename Heuristic>
+void
+hpa_star_search(
+    const Graph& graph,
+    HpaGraph<typename Graph::movement_t>& hpa,
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Graph::movement_t Movement;
+    typedef typename Workspace::cost_t CostType;
+
+    const Location& start = graph.getStart();
+    const Location& goal = graph.getGoal();
+
+    workspace.resize(graph.getRows(), graph.getColumns());
+
+    hpa.refresh(workspace);
+
+    std::vector<Location> path;
+
+    if (graph.passable(start) && graph.passable(goal)) {
+        HpaQueryView<Movement> abstract(hpa, start, goal);
+        PriorityQueue<Location, CostType> frontier;
+        std::vector<Location> waypoints, segment;
+
+        abstract.connect(workspace);
+        a_star_search(abstract, workspace, heuristic, frontier);
+        search_reconstruct_path(abstract, workspace, waypoints);
+
+        // Waypoints in different clusters are next to each other, the rest
+        // are joined by a search inside their cluster
+        for (std::size_t i = 0; i + 1 < waypoints.size(); ++i) {
+            const Location& from = waypoints[i];
+            const Location& to = waypoints[i + 1];
+            int id = hpa.clusterOf(from);
+
+            if (path.empty())
+                path.push_back(from);
+
+            if (hpa.clusterOf(to) != id) {
+                path.push_back(to);
+                continue;
+            }
+
+            graph::ClusterView<Movement> inside(
+                hpa.getBoard(), hpa.cluster(id).area, from, to
+            );
+
+            segment.clear();
+
+            a_star_search(inside, workspace, heuristic, frontier);
+            search_reconstruct_path(inside, workspace, segment);
+
+            path.insert(path.end(), segment.begin() + 1, segment.end());
+        }
+    }
+
+    workspace.reset();
+    workspace.visit(start, start, 0);
+
+    CostType cost = 0;
+
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        cost += graph.cost(path[i - 1], path[i]);
+        workspace.visit(path[i], path[i - 1], cost);
+    }
+}
+
+#endif /* HPA_STAR_H */
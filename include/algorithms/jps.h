@@ -0,0 +1,416 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef JPS_H
+#define JPS_H       1
+
+#include <cstddef>          /* std::size_t          */
+#include <vector>           /* std::vector          */
+
+#include "../graph/Movement.h"  /* graph::Neighbors  */
+
+#include "a_star.h"         /* HeuristicPriority    */
+#include "PriorityQueue.h"
+#include "SearchWorkspace.h"
+
+/*
+ * Jump Point Search (Harabor and Grastien, 2011) for 8-way movement, with or
+ * without corner cutting as the graph's movement_t says.
+ *
+ * Instead of pushing every neighbor, it walks straight and diagonal lines
+ * and only stops at cells with a forced neighbor (a cell that can only be
+ * reached optimally through this one), so an open area costs a handful of
+ * frontier operations instead of one per cell.
+ *
+ * Every step is assumed to cost the same. On boards without weights it
+ * finds the same costs as a_star_search. Weights are walked over like empty
+ * cells, although their cost is still charged, so paths through them may
+ * not be the cheapest.
+ */
+
+inline int
+jps_sign(const int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// Whether the movement policy allows stepping from position by (dx, dy)
+template<typename Graph>
+inline bool
+jps_can_step(
+    const Graph& graph,
+    const typename Graph::location_t position,
+    const int dx, const int dy
+)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Graph::movement_t Movement;
+
+    if (!graph.passable(Location{position.x + dx, position.y + dy}))
+        return false;
+
+    if constexpr (!Movement::corner_cutting) {
+        if (dx != 0 && dy != 0) {
+            return graph.passable(Location{position.x + dx, position.y})
+                && graph.passable(Location{position.x, position.y + dy});
+        }
+    }
+
+    return true;
+}
+
+// Whether position, reached moving by (dx, dy), has a forced neighbor
+template<typename Graph>
+inline bool
+jps_forced(
+    const Graph& graph,
+    const typename Graph::location_t p,
+    const int dx, const int dy
+)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Graph::movement_t Movement;
+
+    auto open = [&graph, p](const int x, const int y) {
+        return graph.passable(Location{p.x + x, p.y + y});
+    };
+
+    if constexpr (Movement::corner_cutting) {
+        if (dx != 0 && dy != 0)
+            return (open(-dx, dy) && !open(-dx, 0))
+                || (open(dx, -dy) && !open(0, -dy));
+        if (dx != 0)
+            return (open(dx, 1) && !open(0, 1))
+                || (open(dx, -1) && !open(0, -1));
+
+        return (open(1, dy) && !open(1, 0))
+            || (open(-1, dy) && !open(-1, 0));
+    }
+    else {
+        // Diagonals never stop by themselves: the straight jumps that
+        // branch off them do
+        if (dx != 0 && dy != 0)
+            return false;
+        if (dx != 0)
+            return (open(0, 1) && !open(-dx, 1))
+                || (open(0, -1) && !open(-dx, -1));
+
+        return (open(1, 0) && !open(1, -dy))
+            || (open(-1, 0) && !open(-1, -dy));
+    }
+}
+
+// Walks from position by (dx, dy) until a jump point, or returns false
+template<typename Graph>
+bool
+jps_jump_straight(
+    const Graph& graph,
+    typename Graph::location_t position,
+    const int dx, const int dy,
+    typename Graph::location_t& jump_point
+)
+{
+    const typename Graph::location_t& goal = graph.getGoal();
+
+    while (jps_can_step(graph, position, dx, dy)) {
+        position.x += dx;
+        position.y += dy;
+
+        if (position == goal || jps_forced(graph, position, dx, dy)) {
+            jump_point = position;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Same, along a diagonal. Stops where a straight jump finds something
+template<typename Graph>
+bool
+jps_jump_diagonal(
+    const Graph& graph,
+    typename Graph::location_t position,
+    const int dx, const int dy,
+    typename Graph::location_t& jump_point
+)
+{
+    const typename Graph::location_t& goal = graph.getGoal();
+    typename Graph::location_t ignored;
+
+    while (jps_can_step(graph, position, dx, dy)) {
+        position.x += dx;
+        position.y += dy;
+
+        if (position == goal
+            || jps_forced(graph, position, dx, dy)
+            || jps_jump_straight(graph, position, dx, 0, ignored)
+            || jps_jump_straight(graph, position, 0, dy, ignored))
+        {
+            jump_point = position;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Directions worth jumping in from position, reached from parent
+template<typename Graph>
+::graph::Neighbors
+jps_directions(
+    const Graph& graph,
+    const typename Graph::location_t position,
+    const typename Graph::location_t parent
+)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Graph::movement_t Movement;
+
+    ::graph::Neighbors dirs;
+
+    // The start has no parent, so every direction is open
+    if (position == parent) {
+        for (const Location& direction : Movement::DIRS)
+            dirs.push_back(direction);
+
+        return dirs;
+    }
+
+    const int dx = jps_sign(position.x - parent.x);
+    const int dy = jps_sign(position.y - parent.y);
+
+    auto open = [&graph, position](const int x, const int y) {
+        return graph.passable(Location{position.x + x, position.y + y});
+    };
+
+    if (dx != 0 && dy != 0) {
+        dirs.push_back({dx, 0});
+        dirs.push_back({0, dy});
+        dirs.push_back({dx, dy});
+
+        if constexpr (Movement::corner_cutting) {
+            if (!open(-dx, 0))
+                dirs.push_back({-dx, dy});
+            if (!open(0, -dy))
+                dirs.push_back({dx, -dy});
+        }
+    }
+    else if (dx != 0) {
+        dirs.push_back({dx, 0});
+
+        for (int side = -1; side <= 1; side += 2) {
+            if constexpr (Movement::corner_cutting) {
+                if (!open(0, side))
+                    dirs.push_back({dx, side});
+            }
+            else if (open(0, side) && !open(-dx, side)) {
+                dirs.push_back({0, side});
+                dirs.push_back({dx, side});
+            }
+        }
+    }
+    else {
+        dirs.push_back({0, dy});
+
+        for (int side = -1; side <= 1; side += 2) {
+            if constexpr (Movement::corner_cutting) {
+                if (!open(side, 0))
+                    dirs.push_back({side, dy});
+            }
+            else if (open(side, 0) && !open(side, -dy)) {
+                dirs.push_back({side, 0});
+                dirs.push_back({side, dy});
+            }
+        }
+    }
+
+    return dirs;
+}
+
+// Cost of the straight or diagonal segment from one cell to another
+template<typename Graph>
+double
+jps_segment_cost(
+    const Graph& graph,
+    typename Graph::location_t from,
+    const typename Graph::location_t to
+)
+{
+    typedef typename Graph::location_t Location;
+
+    const int dx = jps_sign(to.x - from.x);
+    const int dy = jps_sign(to.y - from.y);
+
+    double cost = 0;
+
+    while (from != to) {
+        Location next = {from.x + dx, from.y + dy};
+
+        cost += graph.cost(from, next);
+        from = next;
+    }
+
+    return cost;
+}
+
+/*
+ * While searching, only jump points get a came_from. This fills in the cells
+ * between them along the path to the goal, so search_reconstruct_path() and
+ * anything else walking came_from see a path of adjacent cells.
+ */
+template<typename Graph, typename Workspace>
+void
+jps_fill_path(const Graph& graph, Workspace& workspace)
+{
+    typedef typename Graph::location_t Location;
+    typedef typename Workspace::cost_t CostType;
+
+    const Location& start = graph.getStart();
+    Location current = graph.getGoal();
+
+    if (!workspace.visited(current))
+        return;
+
+    // Read the whole chain first: filling in may overwrite parts of it
+    std::vector<Location> jump_points;
+    std::vector<CostType> costs;
+
+    while (current != start) {
+        jump_points.push_back(current);
+        costs.push_back(workspace.costSoFar(current));
+
+        current = workspace.cameFrom(current);
+    }
+
+    jump_points.push_back(start);
+    costs.push_back(0);
+
+    // From the goal backwards, so wherever the path crosses itself the cell
+    // keeps the came_from that is closer to the start
+    for (std::size_t i = 0; i + 1 < jump_points.size(); ++i) {
+        const Location to = jump_points[i];
+        Location from = jump_points[i + 1];
+        CostType cost = costs[i + 1];
+
+        const int dx = jps_sign(to.x - from.x);
+        const int dy = jps_sign(to.y - from.y);
+
+        while (from != to) {
+            Location next = {from.x + dx, from.y + dy};
+
+            cost += graph.cost(from, next);
+            workspace.visit(next, from, next == to ? costs[i] : cost);
+
+            from = next;
+        }
+    }
+}
+
+// Successors of a cell are the jump points in the directions worth trying
+struct JumpPoints {
+    template<typename Graph, typename Workspace, typename Visit>
+    inline void expand(
+        const Graph& graph, const Workspace& workspace,
+        const typename Graph::location_t current, Visit visit
+    ) const
+    {
+        typename Graph::location_t jump_point = {};
+        bool found = false;
+
+        ::graph::Neighbors dirs = jps_directions(
+            graph, current, workspace.cameFrom(current)
+        );
+
+        for (typename Graph::location_t dir : dirs) {
+            if (dir.x != 0 && dir.y != 0)
+                found = jps_jump_diagonal(
+                    graph, current, dir.x, dir.y, jump_point
+                );
+            else
+                found = jps_jump_straight(
+                    graph, current, dir.x, dir.y, jump_point
+                );
+
+            if (found)
+                visit(jump_point);
+        }
+    }
+
+    template<typename Graph>
+    inline double cost(
+        const Graph& graph,
+        const typename Graph::location_t from,
+        const typename Graph::location_t to
+    ) const
+    {
+        return jps_segment_cost(graph, from, to);
+    }
+
+    template<typename Graph, typename Workspace>
+    inline void finish(const Graph& graph, Workspace& workspace) const
+    {
+        jps_fill_path(graph, workspace);
+    }
+};
+
+template<typename Heuristic>
+using JumpPointSearch = BestFirstSearch<
+    HeuristicPriority<Heuristic>, PriorityQueue, JumpPoints
+>;
+
+/*
+ * heuristic and frontier work as in a_star_search, e.g. Octile. The graph
+ * must be 8-way and have a movement_t, like graph::BoardView.
+ */
+template<typename Graph, typename Workspace, typename Heuristic,
+    typename Frontier>
+void
+jps_search(
+    const Graph& graph,
+    Workspace& workspace,
+    Heuristic heuristic,
+    Frontier& frontier
+)
+{
+    static_assert(Graph::movement_t::diagonals,
+        "Jump Point Search needs diagonal moves");
+
+    JumpPointSearch<Heuristic>(HeuristicPriority<Heuristic>(heuristic))(
+        graph, workspace, frontier
+    );
+}
+
+// Same, with a fresh Queue, e.g. jps_search<IndexedHeap>(graph, ws, h)
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace, typename Heuristic
+>
+void
+jps_search(
+    const Graph& graph,
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    Queue<typename Graph::location_t, typename Workspace::cost_t> frontier;
+
+    jps_search(graph, workspace, heuristic, frontier);
+}
+
+#endif /* JPS_H */
@@ -0,0 +1,168 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef JPS_PLUS_H
+#define JPS_PLUS_H  1
+
+#include <algorithm>        /* std::min             */
+#include <cstdlib>          /* std::abs             */
+
+#include "a_star.h"         /* HeuristicPriority    */
+#include "jps.h"            /* JumpPoints           */
+#include "JumpTable.h"
+#include "PriorityQueue.h"
+
+/*
+ * Where the jump from position in direction dir lands, looking it up in the
+ * table instead of walking there. Besides the stored jump points, it stops
+ * at the goal if it is on the way, or for diagonals at the cell that shares
+ * a row or column with it ("target jump point").
+ */
+template<typename Movement>
+bool
+jps_plus_jump(
+    const JumpTable<Movement>& table,
+    const graph::Location position,
+    const int dir,
+    const graph::Location goal,
+    graph::Location& jump_point
+)
+{
+    const graph::Location& d = Movement::DIRS[dir];
+    const int distance = table.distance(position, dir);
+    const int reach = std::abs(distance);
+
+    const int to_goal_x = goal.x - position.x;
+    const int to_goal_y = goal.y - position.y;
+
+    if (d.x == 0 || d.y == 0) {
+        // Exactly ahead
+        int steps = (d.x != 0) ? to_goal_x * d.x : to_goal_y * d.y;
+        bool in_line = (d.x != 0) ? to_goal_y == 0 : to_goal_x == 0;
+
+        if (in_line && steps > 0 && steps <= reach) {
+            jump_point = goal;
+            return true;
+        }
+    }
+    else if (jps_sign(to_goal_x) == d.x && jps_sign(to_goal_y) == d.y) {
+        // Somewhere in the quadrant ahead
+        int steps = std::min(std::abs(to_goal_x), std::abs(to_goal_y));
+
+        if (steps <= reach) {
+            jump_point = {position.x + d.x * steps, position.y + d.y * steps};
+            return true;
+        }
+    }
+
+    if (distance <= 0)
+        return false;
+
+    jump_point = {position.x + d.x * distance, position.y + d.y * distance};
+
+    return true;
+}
+
+// JumpPoints, with each jump looked up in table instead of walked
+template<typename Movement>
+struct JumpTableLookups : JumpPoints {
+    const JumpTable<Movement>* table;
+
+    explicit JumpTableLookups(const JumpTable<Movement>& table_)
+    : table(&table_) {}
+
+    template<typename Graph, typename Workspace, typename Visit>
+    inline void expand(
+        const Graph& graph, const Workspace& workspace,
+        const typename Graph::location_t current, Visit visit
+    ) const
+    {
+        typename Graph::location_t jump_point = {};
+
+        ::graph::Neighbors dirs = jps_directions(
+            graph, current, workspace.cameFrom(current)
+        );
+
+        for (typename Graph::location_t dir : dirs) {
+            if (jps_plus_jump<Movement>(
+                    *table, current, table->direction(dir.x, dir.y),
+                    graph.getGoal(), jump_point
+                ))
+            {
+                visit(jump_point);
+            }
+        }
+    }
+};
+
+template<typename Movement, typename Heuristic>
+using JpsPlusSearch = BestFirstSearch<
+    HeuristicPriority<Heuristic>, PriorityQueue, JumpTableLookups<Movement>
+>;
+
+// Engine for table, ready to take a sink or stop rule like any other
+template<typename Movement, typename Heuristic>
+JpsPlusSearch<Movement, Heuristic>
+jps_plus_engine(
+    const JumpTable<Movement>& table, Heuristic heuristic = Heuristic()
+)
+{
+    return JpsPlusSearch<Movement, Heuristic>(
+        HeuristicPriority<Heuristic>(heuristic), NullSink(), StopAtGoal(),
+        JumpTableLookups<Movement>(table)
+    );
+}
+
+/*
+ * Jump Point Search using a JumpTable built for the same board and movement
+ * policy as the graph (a graph::BoardView), so each jump is a lookup. Same
+ * results as jps_search(), and the same caveats about weights.
+ */
+template<typename Graph, typename Workspace, typename Heuristic,
+    typename Frontier>
+void
+jps_plus_search(
+    const Graph& graph,
+    const JumpTable<typename Graph::movement_t>& table,
+    Workspace& workspace,
+    Heuristic heuristic,
+    Frontier& frontier
+)
+{
+    jps_plus_engine(table, heuristic)(graph, workspace, frontier);
+}
+
+// Same, with a fresh Queue
+template<
+    template<typename, typename> class Queue = PriorityQueue,
+    typename Graph, typename Workspace, typename Heuristic
+>
+void
+jps_plus_search(
+    const Graph& graph,
+    const JumpTable<typename Graph::movement_t>& table,
+    Workspace& workspace,
+    Heuristic heuristic
+)
+{
+    Queue<typename Graph::location_t, typename Workspace::cost_t> frontier;
+
+    jps_plus_search(graph, table, workspace, heuristic, frontier);
+}
+
+#endif /* JPS_PLUS_H */
@@ -19,18 +19,28 @@
 #ifndef SEARCH_ALGORITHM_H
 #define SEARCH_ALGORITHM_H  1
 
-#include <stdexcept>        /* std::out_of_range */
+#include <algorithm>        /* std::reverse */
+#include <vector>           /* std::vector  */
 
 #include "a_star.h"
 #include "bfs.h"
+#include "bidirectional.h"
 #include "dijkstra.h"
+#include "jps.h"
+#include "jps_plus.h"
 
+#include "BucketQueue.h"
+#include "RadixHeap.h"
+#include "ResumableSearch.h"
+#include "SearchControl.h"
+#include "SearchStats.h"
 
-template<typename Graph>
+
+template<typename Graph, typename Workspace>
 bool
 search_reconstruct_path(
     const Graph& graph,
-    std::unordered_map<typename Graph::location_t, typename Graph::location_t>& came_from,
+    const Workspace& workspace,
     std::vector<typename Graph::location_t>& path
 )
 {
@@ -45,15 +55,14 @@ search_reconstruct_path(
     while (current != start) {
         path.push_back(current);
 
-        try {
-            current = came_from.at(current);
-        }
-        catch (std::out_of_range& e) {
+        if (!workspace.visited(current)) {
             found_path = false;
 
             path.clear();
             break;
         }
+
+        current = workspace.cameFrom(current);
     }
 
     if (found_path) {
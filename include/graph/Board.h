@@ -19,77 +19,39 @@
 #ifndef BOARD_H
 #define BOARD_H   1
 
-#include <array>            /* std::array           */
-#include <tuple>            /* std::tie             */
-#include <unordered_map>    /* std::unordered_map   */
-#include <unordered_set>    /* std::unordered_set   */
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint8_t         */
 #include <vector>           /* std::vector          */
 
-namespace graph {
-
-#ifdef ALLOW_DIAGONALS
-#define N_DIRS              8
-#else
-#define N_DIRS              4
-#endif
+#include "Location.h"       /* graph::Location      */
+#include "Movement.h"       /* graph::Neighbors, movement policies */
 
-    struct Location {
-        int x;
-        int y;
-
-        Location& operator= (const Location& p)
-        {
-            if (this ==  &p)
-                return * this;
-
-            x = p.x;
-            y = p.y;
-
-            return *this;
-        }
-
-        bool operator== (const Location& p) const
-        {
-            return x == p.x && y == p.y;
-        }
-
-        bool operator!= (const Location& p) const
-        {
-            return !(*this == p);
-        }
-
-        bool operator< (const Location& p) const
-        {
-            return std::tie(x, y) < std::tie(p.x, p.y);
-        }
-        bool operator> (const Location& p) const
-        {
-            return p < *this;
-        }
-    };
-}
+namespace graph {
+    /*
+     * Gets told about every cell whose contents change, so anything built
+     * from a board (e.g. precomputed tables) can patch itself instead of
+     * being rebuilt. See Board::addListener().
+     */
+    class BoardListener {
+    public:
+        virtual ~BoardListener() = default;
 
-namespace std {
-    template<>
-        struct hash<graph::Location> {
-        std::size_t operator()(const graph::Location& position) const noexcept
-        {
-            // Using ElegantPairing as described by Matthew Szudzik 
-            // http://szudzik.com/ElegantPairing.pdf
-            return std::hash<int>()(
-                    position.x >= position.y ? 
-                    position.x * position.x + position.x + position.y :
-                    position.x + position.y * position.y 
-                );
-        }
+        // A wall or weight was added or removed at position
+        virtual void cellChanged(const Location position) = 0;
+        // Every cell was emptied, or replaced by an assignment, at once
+        virtual void boardCleared() = 0;
     };
-}
 
-namespace graph {
     class Board {
     public:
         typedef Location location_t;    // Simplifies algorithms code
 
+        // Order in which neighbors() lists the cells around a position
+        enum class NeighborOrder {
+            fixed,          // Always DIRS order
+            alternating     // DIRS order reversed on even cells (nicer paths)
+        };
+
         enum class ElementType {
             EMPTY = 0,
             START,
@@ -101,17 +63,35 @@ namespace graph {
 
         Board(int rows_, int columns_);
 
+        // Copies the cells, not the listeners: those watch the original
+        Board(const Board& other);
+        // Keeps this board's listeners and tells them every cell changed
+        Board& operator= (const Board& other);
+
+        int getRows() const;
+        int getColumns() const;
+
         bool in_bounds(const Location position) const;
         bool passable(const Location position) const;
         
         bool isStartGoal(const Location position) const;
 
-        std::vector<Location> neighbors(const Location position) const;
+        // Free cells around position, following a movement policy
+        template<typename Movement = EightWay>
+        Neighbors neighbors(const Location position) const;
+        // 1, or 5 if to is a weight; times DIAGONAL_STEP on diagonal steps
         double cost(const Location from, const Location to) const;
 
 
         void clear();
 
+        // Listeners are not owned and must be removed before they die
+        void addListener(BoardListener* listener);
+        void removeListener(BoardListener* listener);
+
+        void setNeighborOrder(const NeighborOrder order);
+        NeighborOrder getNeighborOrder() const;
+
         const Location& getStart() const;
         const Location& getGoal() const;
 
@@ -126,16 +106,101 @@ namespace graph {
         
         ElementType getElementTypeAt(const Location position) const;
     private:
-        static std::array<Location, N_DIRS> DIRS;
+        // Each cell is a set of flags, so a weight survives under a wall
+        // exactly like it did when walls and weights lived in two sets
+        enum CellFlags : std::uint8_t {
+            CELL_EMPTY  = 0,
+            CELL_WALL   = 1 << 0,
+            CELL_WEIGHT = 1 << 1
+        };
 
         int rows, columns;
 
         Location start;
         Location goal;
 
-        std::unordered_set<Location> walls;
-        std::unordered_set<Location> weights;
+        NeighborOrder neighbor_order;
+
+        // Row-major cells surrounded by a one cell wide border of walls, so
+        // neighbors() never has to check bounds.
+        // cells.size() == (rows + 2) * (columns + 2)
+        int stride;
+        std::vector<std::uint8_t> cells;
+
+        std::vector<BoardListener*> listeners;
+
+        inline std::size_t cellIndex(const Location position) const
+        {
+            return (std::size_t) (position.y + 1) * stride + position.x + 1;
+        }
+
+        void initCells();
+
+        // Tells the listeners if the cell is not what it was before
+        void notify(const Location position, const std::uint8_t before);
+
+        template<typename Movement>
+        inline void expand(
+            const Location position, const int dir, Neighbors& results
+        ) const;
     };
+
+    // Inline, as searches like jps_search() call them for every step
+    inline bool Board::in_bounds(const Location position) const
+    {
+        return position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows;
+    }
+
+    inline bool Board::passable(const Location position) const
+    {
+        // Anything outside the board behaves as a wall
+        return in_bounds(position) && !(cells[cellIndex(position)] & CELL_WALL);
+    }
+
+    template<typename Movement>
+    inline void Board::expand(
+        const Location position, const int dir, Neighbors& results
+    ) const
+    {
+        const Location& direction = Movement::DIRS[dir];
+        Location next = {position.x + direction.x, position.y + direction.y};
+
+        // The border of walls makes an in_bounds() check unnecessary
+        if (cells[cellIndex(next)] & CELL_WALL)
+            return;
+
+        if constexpr (Movement::diagonals && !Movement::corner_cutting) {
+            if (direction.x != 0 && direction.y != 0
+                && ((cells[cellIndex({next.x, position.y})]
+                    | cells[cellIndex({position.x, next.y})]) & CELL_WALL))
+            {
+                return;
+            }
+        }
+
+        results.push_back(next);
+    }
+
+    template<typename Movement>
+    Neighbors Board::neighbors(const Location position) const
+    {
+        Neighbors results;
+
+        if (neighbor_order == NeighborOrder::alternating
+            && (position.x + position.y) % 2 == 0)
+        {
+            // Walking DIRS backwards on even cells makes paths look nicer
+            for (int i = Movement::n_dirs - 1; i >= 0; --i)
+                expand<Movement>(position, i, results);
+        }
+        else {
+            for (int i = 0; i < Movement::n_dirs; ++i)
+                expand<Movement>(position, i, results);
+        }
+
+        return results;
+    }
 }
 
 
@@ -0,0 +1,81 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef BOARDVIEW_H
+#define BOARDVIEW_H 1
+
+#include "Board.h"          /* graph::Board, graph::Location */
+#include "Movement.h"       /* movement policies */
+
+namespace graph {
+    /*
+     * Read-only view of a board that the search algorithms walk with a given
+     * movement policy. Start and goal default to the board's, but each view
+     * can carry its own, so one board can serve many queries.
+     */
+    template<typename Movement, typename Grid = Board>
+    class BoardView {
+    public:
+        typedef typename Grid::location_t location_t;
+        typedef Movement movement_t;
+
+        explicit BoardView(const Grid& grid_)
+        : BoardView(grid_, grid_.getStart(), grid_.getGoal()) {}
+
+        BoardView(
+            const Grid& grid_, const location_t start_, const location_t goal_
+        )
+        : grid(grid_), start(start_), goal(goal_) {}
+
+        inline bool in_bounds(const location_t position) const
+        {
+            return grid.in_bounds(position);
+        }
+
+        inline bool passable(const location_t position) const
+        {
+            return grid.passable(position);
+        }
+
+        inline Neighbors neighbors(const location_t position) const
+        {
+            return grid.template neighbors<Movement>(position);
+        }
+
+        inline double cost(const location_t from, const location_t to) const
+        {
+            return grid.cost(from, to);
+        }
+
+        int getRows() const { return grid.getRows(); }
+        int getColumns() const { return grid.getColumns(); }
+
+        const location_t& getStart() const { return start; }
+        const location_t& getGoal() const { return goal; }
+
+        const Grid& getGrid() const { return grid; }
+
+    private:
+        const Grid& grid;
+
+        location_t start;
+        location_t goal;
+    };
+}
+
+#endif /* BOARDVIEW_H */
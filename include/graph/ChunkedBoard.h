@@ -0,0 +1,227 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef CHUNKED_BOARD_H
+#define CHUNKED_BOARD_H 1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint8_t, std::uint64_t */
+#include <memory>           /* std::unique_ptr      */
+#include <unordered_map>    /* std::unordered_map   */
+
+#include "Board.h"          /* graph::Board::ElementType */
+#include "ClusterView.h"    /* graph::Area          */
+#include "Location.h"       /* graph::Location      */
+#include "Movement.h"       /* graph::Neighbors, movement policies */
+
+namespace graph {
+    /*
+     * Board for worlds too large for one array per cell: the cells are split
+     * in TILE_SIZE x TILE_SIZE tiles, and a tile only gets an array once its
+     * cells differ. A tile that is all the same, walls or weights, is one
+     * byte, and an empty one is not stored at all. Memory follows what the
+     * map holds, not its area.
+     *
+     * fill() sets whole tiles at once. Single cell edits that leave a tile
+     * uniform again keep its array until compact().
+     *
+     * Searches walk it through BoardView<Movement, ChunkedBoard>, with a
+     * SparseWorkspace and a PriorityQueue when the board is too large for
+     * SearchWorkspace and IndexedHeap. Like a Board, start and goal can not
+     * be walls and neighbors come in NeighborOrder::alternating order.
+     */
+    class ChunkedBoard {
+    public:
+        typedef Location location_t;
+
+        static constexpr int TILE_BITS = 6;
+        static constexpr int TILE_SIZE = 1 << TILE_BITS;
+
+        ChunkedBoard(int rows_, int columns_);
+
+        int getRows() const;
+        int getColumns() const;
+
+        bool in_bounds(const Location position) const;
+        bool passable(const Location position) const;
+
+        template<typename Movement = EightWay>
+        Neighbors neighbors(const Location position) const;
+
+        // Same costs as Board::cost()
+        double cost(const Location from, const Location to) const;
+
+        const Location& getStart() const;
+        const Location& getGoal() const;
+
+        bool setStart(const Location position);
+        bool setGoal(const Location position);
+        bool setWall(const Location position);
+        bool setWeight(const Location position);
+        bool setEmpty(const Location position);
+
+        // Sets every cell of area (clipped to the board) to EMPTY, WALL or
+        // WEIGHT. Walls skip the start and the goal
+        void fill(const Area& area, const Board::ElementType element);
+
+        // Drops the arrays of tiles whose cells became all the same
+        void compact();
+
+        // Tiles with an array of their own, and tiles stored as one value
+        std::size_t countArrayTiles() const;
+        std::size_t countUniformTiles() const;
+
+        // Approximate bytes taken by the tiles
+        std::size_t memoryUsage() const;
+
+    private:
+        enum CellType : std::uint8_t {
+            CELL_EMPTY = 0,
+            CELL_WALL,
+            CELL_WEIGHT
+        };
+
+        static constexpr int TILE_MASK = TILE_SIZE - 1;
+        static constexpr int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+        struct Tile {
+            std::uint8_t uniform;
+            // nullptr while every cell is uniform
+            std::unique_ptr<std::uint8_t[]> cells;
+        };
+
+        int rows, columns;
+
+        Location start;
+        Location goal;
+
+        // Missing tiles are empty
+        std::unordered_map<std::uint64_t, Tile> tiles;
+
+        static inline std::uint64_t tileKey(const Location position)
+        {
+            return ((std::uint64_t) (position.y >> TILE_BITS) << 32)
+                | (std::uint32_t) (position.x >> TILE_BITS);
+        }
+
+        static inline int cellIndex(const Location position)
+        {
+            return (position.y & TILE_MASK) * TILE_SIZE
+                + (position.x & TILE_MASK);
+        }
+
+        // nullptr for empty tiles
+        inline const Tile* tileAt(const Location position) const
+        {
+            auto found = tiles.find(tileKey(position));
+
+            return (found == tiles.end()) ? nullptr : &found->second;
+        }
+
+        static inline std::uint8_t cellIn(
+            const Tile* tile, const Location position
+        )
+        {
+            if (!tile)
+                return CELL_EMPTY;
+
+            return tile->cells ? tile->cells[cellIndex(position)]
+                : tile->uniform;
+        }
+
+        inline std::uint8_t cellAt(const Location position) const
+        {
+            return cellIn(tileAt(position), position);
+        }
+
+        bool setCell(const Location position, const std::uint8_t cell);
+        void fillTile(const std::uint64_t key, const std::uint8_t cell);
+
+        template<typename Movement, typename Free>
+        inline void expand(
+            const Location position, const int dir, Free is_free,
+            Neighbors& results
+        ) const;
+    };
+
+    inline bool ChunkedBoard::in_bounds(const Location position) const
+    {
+        return position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows;
+    }
+
+    inline bool ChunkedBoard::passable(const Location position) const
+    {
+        return in_bounds(position) && cellAt(position) != CELL_WALL;
+    }
+
+    template<typename Movement, typename Free>
+    inline void ChunkedBoard::expand(
+        const Location position, const int dir, Free is_free,
+        Neighbors& results
+    ) const
+    {
+        const Location& direction = Movement::DIRS[dir];
+        Location next = {position.x + direction.x, position.y + direction.y};
+
+        if (!is_free(next))
+            return;
+
+        if constexpr (Movement::diagonals && !Movement::corner_cutting) {
+            if (direction.x != 0 && direction.y != 0
+                && (!is_free({next.x, position.y})
+                    || !is_free({position.x, next.y})))
+            {
+                return;
+            }
+        }
+
+        results.push_back(next);
+    }
+
+    template<typename Movement>
+    Neighbors ChunkedBoard::neighbors(const Location position) const
+    {
+        Neighbors results;
+
+        int x = position.x & TILE_MASK, y = position.y & TILE_MASK;
+        bool inner = x > 0 && x < TILE_MASK && y > 0 && y < TILE_MASK
+            && position.x + 1 < columns && position.y + 1 < rows;
+
+        // Away from the tile's and the board's edges every neighbor is in
+        // the same tile, so it is looked up once
+        const Tile* tile = inner ? tileAt(position) : nullptr;
+
+        auto is_free = [&](const Location next) {
+            return inner ? cellIn(tile, next) != CELL_WALL : passable(next);
+        };
+
+        if ((position.x + position.y) % 2 == 0) {
+            for (int i = Movement::n_dirs - 1; i >= 0; --i)
+                expand<Movement>(position, i, is_free, results);
+        }
+        else {
+            for (int i = 0; i < Movement::n_dirs; ++i)
+                expand<Movement>(position, i, is_free, results);
+        }
+
+        return results;
+    }
+}
+
+#endif /* CHUNKED_BOARD_H */
@@ -0,0 +1,104 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef CLUSTERVIEW_H
+#define CLUSTERVIEW_H 1
+
+#include "Board.h"          /* graph::Board, graph::Location */
+#include "Movement.h"       /* movement policies */
+
+namespace graph {
+    // Rectangle of cells, from top_left up to (not including) bottom_right
+    struct Area {
+        Location top_left;
+        Location bottom_right;
+
+        inline bool contains(const Location position) const
+        {
+            return position.x >= top_left.x && position.x < bottom_right.x
+                && position.y >= top_left.y && position.y < bottom_right.y;
+        }
+    };
+
+    /*
+     * Like BoardView, but searches can not leave area. Locations are still
+     * the board's, so the same workspace serves every cluster.
+     *
+     * A reversed view charges each step as if it was taken the other way
+     * round, so a search from the goal finds the cost of reaching it.
+     */
+    template<typename Movement, typename Grid = Board>
+    class ClusterView {
+    public:
+        typedef typename Grid::location_t location_t;
+        typedef Movement movement_t;
+
+        ClusterView(
+            const Grid& grid_, const Area area_,
+            const location_t start_, const location_t goal_,
+            const bool reversed_ = false
+        )
+        : grid(grid_), area(area_), start(start_), goal(goal_),
+          reversed(reversed_) {}
+
+        inline bool in_bounds(const location_t position) const
+        {
+            return area.contains(position);
+        }
+
+        inline bool passable(const location_t position) const
+        {
+            return area.contains(position) && grid.passable(position);
+        }
+
+        inline Neighbors neighbors(const location_t position) const
+        {
+            Neighbors inside;
+
+            for (location_t next : grid.template neighbors<Movement>(position))
+                if (area.contains(next))
+                    inside.push_back(next);
+
+            return inside;
+        }
+
+        inline double cost(const location_t from, const location_t to) const
+        {
+            return reversed ? grid.cost(to, from) : grid.cost(from, to);
+        }
+
+        int getRows() const { return grid.getRows(); }
+        int getColumns() const { return grid.getColumns(); }
+
+        const location_t& getStart() const { return start; }
+        const location_t& getGoal() const { return goal; }
+
+        const Area& getArea() const { return area; }
+
+    private:
+        const Grid& grid;
+        Area area;
+
+        location_t start;
+        location_t goal;
+
+        bool reversed;
+    };
+}
+
+#endif /* CLUSTERVIEW_H */
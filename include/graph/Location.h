@@ -0,0 +1,79 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef LOCATION_H
+#define LOCATION_H  1
+
+#include <cstddef>          /* std::size_t          */
+#include <functional>       /* std::hash            */
+#include <tuple>            /* std::tie             */
+
+namespace graph {
+    struct Location {
+        int x;
+        int y;
+
+        Location& operator= (const Location& p)
+        {
+            if (this ==  &p)
+                return * this;
+
+            x = p.x;
+            y = p.y;
+
+            return *this;
+        }
+
+        bool operator== (const Location& p) const
+        {
+            return x == p.x && y == p.y;
+        }
+
+        bool operator!= (const Location& p) const
+        {
+            return !(*this == p);
+        }
+
+        bool operator< (const Location& p) const
+        {
+            return std::tie(x, y) < std::tie(p.x, p.y);
+        }
+        bool operator> (const Location& p) const
+        {
+            return p < *this;
+        }
+    };
+}
+
+namespace std {
+    template<>
+        struct hash<graph::Location> {
+        std::size_t operator()(const graph::Location& position) const noexcept
+        {
+            // Using ElegantPairing as described by Matthew Szudzik 
+            // http://szudzik.com/ElegantPairing.pdf
+            return std::hash<int>()(
+                    position.x >= position.y ? 
+                    position.x * position.x + position.x + position.y :
+                    position.x + position.y * position.y 
+                );
+        }
+    };
+}
+
+#endif /* LOCATION_H */
@@ -0,0 +1,75 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef MAPFILE_H
+#define MAPFILE_H   1
+
+#include <istream>          /* std::istream         */
+#include <memory>           /* std::unique_ptr      */
+#include <ostream>          /* std::ostream         */
+#include <string>           /* std::string          */
+#include <vector>           /* std::vector          */
+
+#include "Board.h"          /* graph::Board         */
+
+namespace graph {
+    /*
+     * Plain text maps, one line per row:
+     *
+     *  .   empty       #   wall        w   weight
+     *  S   start       G   goal
+     *
+     * Every row must be as wide as the first one. Empty lines at the end are
+     * ignored, and so is a '\r' at the end of a line. Start and goal default
+     * to the top left cell, which then must not be a wall.
+     */
+
+    // nullptr if the map is malformed
+    std::unique_ptr<Board> read_text_map(std::istream& in);
+
+    void write_text_map(std::ostream& out, const Board& board);
+
+    /*
+     * MovingAI benchmark maps (https://movingai.com/benchmarks/formats.html):
+     * a "type octile" header, "height", "width" and "map", then the rows.
+     * '.', 'G' and 'S' are free, anything else is a wall, as in the
+     * benchmark's own solutions. Those use 8-way movement without corner
+     * cutting, i.e. graph::EightWayNoCornerCutting.
+     *
+     * Start and goal are both left on the first free cell.
+     */
+
+    // nullptr if the map is malformed or has no free cell
+    std::unique_ptr<Board> read_movingai_map(std::istream& in);
+
+    // One line of a MovingAI .scen file
+    struct Scenario {
+        int bucket;
+        std::string map;
+        int width, height;
+        Location start, goal;
+        double optimal;
+    };
+
+    // Appends the scenarios in a "version 1" .scen file. False if malformed
+    bool read_movingai_scenarios(
+        std::istream& in, std::vector<Scenario>& scenarios
+    );
+}
+
+#endif /* MAPFILE_H */
@@ -0,0 +1,168 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef MAPPED_BOARD_H
+#define MAPPED_BOARD_H  1
+
+#include <cstddef>          /* std::size_t          */
+#include <cstdint>          /* std::uint64_t        */
+#include <string>           /* std::string          */
+
+#include "Board.h"          /* graph::Board         */
+#include "Location.h"       /* graph::Location      */
+#include "Movement.h"       /* graph::Neighbors, movement policies */
+
+namespace graph {
+    /*
+     * Read-only board backed by a memory-mapped file, so opening one costs
+     * the same whatever its size: pages are read as searches touch them, and
+     * processes mapping the same file share them in the page cache.
+     *
+     * The file is a header and one bit per cell, free or not, then one more
+     * bit per cell, weight or not, only if the board has weights. Rows are
+     * padded to 64 bit words. Native byte order, like the landmark tables.
+     * save() writes one from a graph::Board.
+     *
+     * Searches walk it like a Board, through BoardView<Movement, MappedBoard>.
+     * Neighbors come in NeighborOrder::alternating order, a Board's default.
+     */
+    class MappedBoard {
+    public:
+        typedef Location location_t;
+
+        MappedBoard();
+        ~MappedBoard();
+
+        MappedBoard(const MappedBoard&) = delete;
+        MappedBoard& operator= (const MappedBoard&) = delete;
+
+        // Closes the current file, if any. False if filename is not a board
+        bool open(const std::string& filename);
+        void close();
+
+        bool isOpen() const;
+
+        static bool save(const std::string& filename, const Board& board);
+
+        int getRows() const;
+        int getColumns() const;
+
+        bool in_bounds(const Location position) const;
+        bool passable(const Location position) const;
+
+        template<typename Movement = EightWay>
+        Neighbors neighbors(const Location position) const;
+
+        // Same costs as Board::cost()
+        double cost(const Location from, const Location to) const;
+
+        const Location& getStart() const;
+        const Location& getGoal() const;
+
+    private:
+        struct Header {
+            char magic[8];
+            std::int32_t rows, columns;
+            std::int32_t start_x, start_y;
+            std::int32_t goal_x, goal_y;
+            std::uint32_t has_weights;
+            // 64 bit words per row
+            std::uint32_t words;
+            // Size of each plane
+            std::uint64_t plane_bytes;
+        };
+
+        void* mapping;
+        std::size_t mapping_size;
+
+        int rows, columns;
+        std::size_t words;
+
+        Location start;
+        Location goal;
+
+        const std::uint64_t* free_cells;
+        // nullptr without weights
+        const std::uint64_t* weights;
+
+        inline bool bit(const std::uint64_t* plane, const Location position)
+            const
+        {
+            return (plane[position.y * words + (position.x >> 6)]
+                >> (position.x & 63)) & 1;
+        }
+
+        template<typename Movement>
+        inline void expand(
+            const Location position, const int dir, Neighbors& results
+        ) const;
+    };
+
+    inline bool MappedBoard::in_bounds(const Location position) const
+    {
+        return position.x >= 0 && position.x < columns
+            && position.y >= 0 && position.y < rows;
+    }
+
+    inline bool MappedBoard::passable(const Location position) const
+    {
+        return in_bounds(position) && bit(free_cells, position);
+    }
+
+    template<typename Movement>
+    inline void MappedBoard::expand(
+        const Location position, const int dir, Neighbors& results
+    ) const
+    {
+        const Location& direction = Movement::DIRS[dir];
+        Location next = {position.x + direction.x, position.y + direction.y};
+
+        if (!passable(next))
+            return;
+
+        if constexpr (Movement::diagonals && !Movement::corner_cutting) {
+            if (direction.x != 0 && direction.y != 0
+                && (!passable({next.x, position.y})
+                    || !passable({position.x, next.y})))
+            {
+                return;
+            }
+        }
+
+        results.push_back(next);
+    }
+
+    template<typename Movement>
+    Neighbors MappedBoard::neighbors(const Location position) const
+    {
+        Neighbors results;
+
+        if ((position.x + position.y) % 2 == 0) {
+            for (int i = Movement::n_dirs - 1; i >= 0; --i)
+                expand<Movement>(position, i, results);
+        }
+        else {
+            for (int i = 0; i < Movement::n_dirs; ++i)
+                expand<Movement>(position, i, results);
+        }
+
+        return results;
+    }
+}
+
+#endif /* MAPPED_BOARD_H */
@@ -0,0 +1,132 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef MOVEMENT_H
+#define MOVEMENT_H  1
+
+#include <array>            /* std::array           */
+#include <cstddef>          /* std::size_t          */
+
+#include "Location.h"       /* graph::Location      */
+
+namespace graph {
+    // Length of a diagonal step, relative to a straight one
+    constexpr double DIAGONAL_STEP = 1.4142135623730951;
+
+    /*
+     * Movement policies. Each one is a constexpr table of directions plus a
+     * few flags, so neighbors<Movement>() loops can be unrolled by the
+     * compiler. Straight directions always come first.
+     */
+
+    struct FourWay {
+        static constexpr int n_dirs = 4;
+        static constexpr bool diagonals = false;
+        static constexpr bool corner_cutting = false;
+
+        static constexpr std::array<Location, n_dirs> DIRS = {{
+            /* East, West, North, South */
+            {1, 0}, {-1, 0},
+            {0, -1}, {0, 1}
+        }};
+    };
+
+    struct EightWay {
+        static constexpr int n_dirs = 8;
+        static constexpr bool diagonals = true;
+        static constexpr bool corner_cutting = true;
+
+        static constexpr std::array<Location, n_dirs> DIRS = {{
+            /* East, West, North, South */
+            {1, 0}, {-1, 0},
+            {0, -1}, {0, 1},
+            /* North-east, north-west, south-east, south-west */
+            {1, -1}, {-1, -1},
+            {1, 1}, {-1, 1}
+        }};
+    };
+
+    // Diagonal steps need both cells they squeeze between to be free
+    struct EightWayNoCornerCutting : EightWay {
+        static constexpr bool corner_cutting = false;
+    };
+
+    // Runtime name for each policy
+    enum class Movement {
+        four_way,
+        eight_way,
+        eight_way_no_corner_cutting
+    };
+
+    /*
+     * Calls f(Policy()) with the policy matching movement, e.g.
+     *
+     *  dispatch_movement(movement, [&](auto policy) {
+     *      typedef decltype(policy) M;
+     *      a_star_search(BoardView<M>(board), workspace, &heuristic);
+     *  });
+     */
+    template<typename F>
+    auto dispatch_movement(const Movement movement, F&& f)
+    {
+        switch (movement) {
+        case Movement::four_way:
+            return f(FourWay());
+
+        case Movement::eight_way_no_corner_cutting:
+            return f(EightWayNoCornerCutting());
+
+        case Movement::eight_way: /* Fallsthrough */
+        default:
+            return f(EightWay());
+        }
+    }
+
+    // Fixed capacity list returned by Board::neighbors(). Lives on the stack,
+    // so expanding a node never touches the heap
+    class Neighbors {
+    public:
+        typedef const Location* const_iterator;
+
+        static constexpr int max_dirs = EightWay::n_dirs;
+
+        Neighbors() : count(0) {}
+
+        inline void push_back(const Location position)
+        {
+            items[count++] = position;
+        }
+
+        inline const_iterator begin() const { return items.data(); }
+        inline const_iterator end() const { return items.data() + count; }
+
+        inline std::size_t size() const { return count; }
+        inline bool empty() const { return count == 0; }
+
+        inline const Location& operator[] (std::size_t i) const
+        {
+            return items[i];
+        }
+
+    private:
+        std::array<Location, max_dirs> items;
+        std::size_t count;
+    };
+}
+
+#endif /* MOVEMENT_H */
@@ -19,25 +19,38 @@
 #ifndef TUIBOARD_H
 #define TUIBOARD_H  1
 
+#include <tuple>             /* std::tuple */
+#include <vector>            /* std::vector */
+
 #include "common.h"          /* Corners, Coordinates, TuiAnswerShow */
 #include "Window.h"          /* TuiWindow */
 
+#include "../algorithms/Components.h"       /* Components */
+#include "../algorithms/DStarLite.h"        /* DStarLite */
+#include "../algorithms/FlowField.h"        /* FlowField */
+#include "../algorithms/SearchWorkspace.h"  /* SearchWorkspace */
 #include "../graph/Board.h"     /* graph::Board, graph::Location */
 
 namespace tui {
+    typedef SearchWorkspace<graph::Location, double> BoardWorkspace;
+
     struct BoardData {
         std::vector<graph::Location> path;
-        std::unordered_map<graph::Location, graph::Location> direction;
-        std::unordered_map<graph::Location, double> cost;
+        BoardWorkspace search;      // came_from and cost_so_far
         double max_cost;
 
+        FlowField flow;
+        // search holds flow: came_from is each cell's next step
+        bool from_flow_field = false;
+
         BoardData& operator= (const BoardData& p) {
             if (this ==  &p)
                 return * this;
 
             path = p.path;
-            direction = p.direction;
-            cost = p.cost;
+            search = p.search;
+            flow = p.flow;
+            from_flow_field = p.from_flow_field;
 
             return *this;
         }
@@ -57,11 +70,25 @@ namespace tui {
         bool clearData();
 
         const graph::Board& getBoard();
+        // Kept up to date with every edit
+        Components<graph::EightWay>& getComponents();
+        // D* Lite state for a movement policy, kept between runs
+        template<typename Movement>
+        DStarLite<Movement>& getPlanner()
+        {
+            return std::get<DStarLite<Movement>>(planners);
+        }
 
         BoardData& getBoardData();
     private:
         int board_rows, board_cols;
         graph::Board board;
+        Components<graph::EightWay> components;
+        std::tuple<
+            DStarLite<graph::FourWay>,
+            DStarLite<graph::EightWay>,
+            DStarLite<graph::EightWayNoCornerCutting>
+        > planners;
         Coordinates cursor;
         BoardData data;
 
@@ -0,0 +1,36 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef TUIINFO_H
+#define TUIINFO_H   1
+
+#include "common.h"
+#include "Window.h"
+
+namespace tui {
+    // Statistics of the last search, under the menu. Never selected
+    class Info final : public Window {
+    public:
+        Info(Corners corners_);
+
+        // opt is the SearchStats to show, or nullptr if there are none
+        void draw(bool active, void* opt = nullptr);
+        bool userInput(const int key, bool& redraw, void* opt);
+    };
+}
+#endif /* TUIINFO_H */
@@ -38,6 +38,11 @@ namespace tui {
             astar = 0,
             bfs,
             dijkstra,
+            jps,
+            dstar_lite,
+            flow_field,
+            toggle_movement,
+            toggle_animation,
             toggle_path,
             toggle_came_from,
             toggle_going_to,
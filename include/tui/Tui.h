@@ -22,13 +22,15 @@
 #include "common.h"
 
 #include "Board.h"
+#include "Info.h"
 #include "Menu.h"
 
+#include "../algorithms/SearchControl.h" /* SearchControl */
+#include "../algorithms/SearchStats.h"   /* SearchStats */
 #include "../graph/Board.h"          /* graph::Location */
+#include "../graph/Movement.h"       /* graph::Movement */
 
 namespace tui {
-    inline double heuristic(graph::Location a, graph::Location b);
-
     class Tui {
     public:
         Tui(int board_rows_, int board_cols_);
@@ -40,7 +42,10 @@ namespace tui {
         enum class AvailableAlgorithms {
             astar,
             bfs,
-            dijkstra
+            dijkstra,
+            jps,
+            dstar_lite,
+            flow_field
         };
     private:
         enum class Windows {
@@ -52,16 +57,35 @@ namespace tui {
 
         Tui::Windows selected_window;
         TuiAnswerShow data_to_display;
+        graph::Movement movement;
+        // Draw best-first searches as they go
+        bool animate;
 
         Board* window_board;
         Menu* window_menu;
+        // nullptr when the terminal is too short for it
+        Info* window_info;
+
+        // Of the last search, if it was one that keeps them
+        SearchStats last_search;
+        bool has_stats;
 
         void drawstdscr();
+        void drawInfo();
         bool userInput(const int key, bool& redraw, bool& exit);
 
-        void calculateWindowsCorners(Corners& board, Corners& menu);
+        void calculateWindowsCorners(
+            Corners& board, Corners& menu, Corners& info
+        );
 
         bool runAlgorithm(Tui::AvailableAlgorithms algorithm);
+        // The search itself, run on its own thread by runAlgorithm() unless
+        // it is animated
+        bool searchBoard(
+            Tui::AvailableAlgorithms algorithm, SearchControl& control
+        );
+
+        void nextMovement();
     };
 }
 #endif /* TUICURSES_H */
\ No newline at end of file
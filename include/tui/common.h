@@ -33,7 +33,10 @@ namespace tui {
     #define CURSOR_Y_OFFSET 1
 
     #define MENU_WIDTH  30
-    #define MENU_HEIGHT 10
+    #define MENU_HEIGHT 15
+
+    // Under the menu, as wide as it
+    #define INFO_HEIGHT 7
 
     #define BORDER_PADDING  1
 
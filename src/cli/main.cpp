@@ -0,0 +1,398 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Headless batch mode: loads a map (see MapFile.h and MappedBoard.h) and a
+ * list of queries, answers them on a BatchSearch and writes a line of
+ * results for each one, in order. Does not need a terminal, nor link
+ * ncurses.
+ */
+
+#include <algorithm>        /* std::min */
+#include <cstdlib>          /* atoi */
+#include <cstring>          /* strcmp */
+#include <fstream>          /* std::ifstream, std::ofstream */
+#include <iostream>         /* std::cerr, std::cout */
+#include <memory>           /* std::unique_ptr */
+#include <sstream>          /* std::istringstream */
+#include <string>           /* std::string, std::getline */
+#include <utility>          /* std::as_const, std::pair */
+#include <vector>           /* std::vector */
+
+#include "graph/Board.h"
+#include "graph/BoardView.h"
+#include "graph/MapFile.h"
+#include "graph/MappedBoard.h"
+
+#include "BatchSearch.h"
+#include "search_algorithm.h"
+
+// Queries answered per batch, so results stream out as they are ready
+#define CHUNK_QUERIES       4096
+
+namespace {
+    typedef std::pair<graph::Location, graph::Location> Query;
+
+    enum class Algorithm {
+        a_star,
+        bfs,
+        dijkstra,
+        jps
+    };
+
+    enum class Format {
+        text,
+        csv,
+        json
+    };
+
+    struct Options {
+        const char* map = nullptr;
+        const char* queries = nullptr;
+        const char* output = nullptr;
+
+        Algorithm algorithm = Algorithm::a_star;
+        graph::Movement movement = graph::Movement::eight_way;
+        Format format = Format::text;
+        // 0 means one per hardware thread
+        unsigned threads = 0;
+    };
+
+    void print_help()
+    {
+        std::cerr
+            << "pinder_cli MAP [QUERIES] [-a ALGORITHM] [-m MOVEMENT]"
+            << " [-f FORMAT] [-o OUTPUT]\n           [-t THREADS]\n\n"
+            << "Runs a search for each line \"START_X START_Y GOAL_X GOAL_Y\""
+            << " of QUERIES,\nor once from the map's start to its goal.\n\n"
+            << "  -a  a_star (default), bfs, dijkstra or jps\n"
+            << "  -m  4, 8 (default) or 8-no-corners\n"
+            << "  -f  text (default), csv or json\n"
+            << "  -o  file to write the results to, instead of stdout\n"
+            << "  -t, --threads  searches running at once, by default one"
+            << " per hardware thread\n\n"
+            << "MAP is a text map, a MovingAI .map or a .pinmap board (see"
+            << " MappedBoard.h).\n"
+            << "Text results are one line per query: index, found (0 or 1),"
+            << " path length in\ncells, cost, expanded nodes and"
+            << " microseconds. csv and json add every\nsearch statistic"
+            << " (see SearchStats.h).\n";
+    }
+
+    bool parse_options(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+
+            if (arg[0] != '-') {
+                if (!options.map)
+                    options.map = arg;
+                else if (!options.queries)
+                    options.queries = arg;
+                else
+                    return false;
+
+                continue;
+            }
+
+            if (i + 1 == argc)
+                return false;
+
+            const char* value = argv[++i];
+
+            if (!strcmp(arg, "-a")) {
+                if (!strcmp(value, "a_star"))
+                    options.algorithm = Algorithm::a_star;
+                else if (!strcmp(value, "bfs"))
+                    options.algorithm = Algorithm::bfs;
+                else if (!strcmp(value, "dijkstra"))
+                    options.algorithm = Algorithm::dijkstra;
+                else if (!strcmp(value, "jps"))
+                    options.algorithm = Algorithm::jps;
+                else
+                    return false;
+            }
+            else if (!strcmp(arg, "-m")) {
+                if (!strcmp(value, "4"))
+                    options.movement = graph::Movement::four_way;
+                else if (!strcmp(value, "8"))
+                    options.movement = graph::Movement::eight_way;
+                else if (!strcmp(value, "8-no-corners"))
+                    options.movement
+                        = graph::Movement::eight_way_no_corner_cutting;
+                else
+                    return false;
+            }
+            else if (!strcmp(arg, "-f")) {
+                if (!strcmp(value, "text"))
+                    options.format = Format::text;
+                else if (!strcmp(value, "csv"))
+                    options.format = Format::csv;
+                else if (!strcmp(value, "json"))
+                    options.format = Format::json;
+                else
+                    return false;
+            }
+            else if (!strcmp(arg, "-o")) {
+                options.output = value;
+            }
+            else if (!strcmp(arg, "-t") || !strcmp(arg, "--threads")) {
+                int threads = atoi(value);
+
+                if (threads < 1)
+                    return false;
+
+                options.threads = threads;
+            }
+            else {
+                return false;
+            }
+        }
+
+        return options.map != nullptr;
+    }
+
+    // Blank lines and lines starting with '#' are skipped
+    bool read_queries(std::istream& in, std::vector<Query>& queries)
+    {
+        std::string line;
+
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            Query query;
+
+            if (line.find_first_not_of(" \t\r") == std::string::npos
+                || line[line.find_first_not_of(" \t")] == '#')
+            {
+                continue;
+            }
+
+            if (!(fields >> query.first.x >> query.first.y
+                    >> query.second.x >> query.second.y))
+            {
+                return false;
+            }
+
+            queries.push_back(query);
+        }
+
+        return true;
+    }
+
+    void write_result(
+        std::ostream& out,
+        const Format format,
+        const std::size_t index,
+        const bool found,
+        const std::size_t length,
+        const double cost,
+        const SearchStats& stats
+    )
+    {
+        switch (format) {
+        case Format::csv:
+            out << index << ',' << found << ',' << length << ',' << cost
+                << ',';
+            search_stats_csv(out, stats);
+            out << '\n';
+            break;
+
+        case Format::json:
+            out << (index > 0 ? ",\n" : "") << "  {\"index\": " << index
+                << ", \"found\": " << (found ? "true" : "false")
+                << ", \"length\": " << length << ", \"cost\": " << cost
+                << ", ";
+            search_stats_json(out, stats);
+            out << '}';
+            break;
+
+        case Format::text:  /* Fallsthrough */
+        default:
+            out << index << ' ' << found << ' ' << length << ' ' << cost
+                << ' ' << stats.expanded << ' ' << stats.seconds * 1e6
+                << '\n';
+            break;
+        }
+    }
+
+    // Answers queries CHUNK_QUERIES at a time, writing each chunk in order
+    template<typename Movement, typename Search, typename Grid>
+    void run_batch(
+        Grid& grid,
+        const std::vector<Query>& queries,
+        const Format format,
+        const unsigned threads,
+        std::ostream& out
+    )
+    {
+        typedef BatchSearch<Movement, Search, Grid> Batch;
+
+        Batch batch(grid, threads);
+        std::vector<Query> chunk;
+        std::vector<typename Batch::Result> results;
+
+        for (std::size_t first = 0; first < queries.size();
+            first += CHUNK_QUERIES)
+        {
+            std::size_t last = std::min(queries.size(), first + CHUNK_QUERIES);
+
+            chunk.assign(queries.begin() + first, queries.begin() + last);
+            batch.run(chunk, results);
+
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                write_result(out, format, first + i, results[i].found,
+                    results[i].path.size(), results[i].cost,
+                    results[i].stats);
+            }
+        }
+    }
+
+    template<typename Movement, typename Grid>
+    void run_queries(
+        Grid& grid,
+        const std::vector<Query>& queries,
+        const Options& options,
+        std::ostream& out
+    )
+    {
+        if (options.format == Format::csv) {
+            out << "index,found,length,cost,";
+            search_stats_csv_header(out);
+            out << '\n';
+        }
+        else if (options.format == Format::json) {
+            out << "[\n";
+        }
+
+        switch (options.algorithm) {
+        case Algorithm::bfs:
+            run_batch<Movement, BatchBfs>(
+                grid, queries, options.format, options.threads, out
+            );
+            break;
+
+        case Algorithm::dijkstra:
+            run_batch<Movement, BatchDijkstra>(
+                grid, queries, options.format, options.threads, out
+            );
+            break;
+
+        case Algorithm::jps:
+            // Like the TUI, A* when there are no diagonals to jump
+            if constexpr (Movement::diagonals) {
+                run_batch<Movement, BatchJps<>>(
+                    grid, queries, options.format, options.threads, out
+                );
+                break;
+            }
+            /* Fallsthrough */
+
+        case Algorithm::a_star:   /* Fallsthrough */
+        default:
+            run_batch<Movement, BatchAStar<Movement>>(
+                grid, queries, options.format, options.threads, out
+            );
+            break;
+        }
+
+        if (options.format == Format::json)
+            out << (queries.empty() ? "]\n" : "\n]\n");
+    }
+
+    // Text or MovingAI map, told apart by the latter's "type" header
+    std::unique_ptr<graph::Board> read_map(const char* filename)
+    {
+        std::ifstream in(filename);
+        std::string first_word;
+
+        if (!(in >> first_word))
+            return nullptr;
+
+        in.clear();
+        in.seekg(0);
+
+        return (first_word == "type")
+            ? graph::read_movingai_map(in)
+            : graph::read_text_map(in);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    if (!parse_options(argc, argv, options)) {
+        print_help();
+        return 1;
+    }
+
+    graph::MappedBoard mapped;
+    std::unique_ptr<graph::Board> board;
+
+    if (!mapped.open(options.map)) {
+        board = read_map(options.map);
+
+        if (!board) {
+            std::cerr << "Can not read map " << options.map << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<Query> queries;
+
+    if (options.queries) {
+        std::ifstream queries_file(options.queries);
+
+        if (!queries_file || !read_queries(queries_file, queries)) {
+            std::cerr << "Can not read queries " << options.queries << "\n";
+            return 1;
+        }
+    }
+    else if (board) {
+        queries.push_back({board->getStart(), board->getGoal()});
+    }
+    else {
+        queries.push_back({mapped.getStart(), mapped.getGoal()});
+    }
+
+    std::ofstream output_file;
+
+    if (options.output) {
+        output_file.open(options.output);
+
+        if (!output_file) {
+            std::cerr << "Can not write to " << options.output << "\n";
+            return 1;
+        }
+    }
+
+    std::ostream& out = options.output ? output_file : std::cout;
+    out.precision(10);
+
+    graph::dispatch_movement(options.movement, [&](auto policy) {
+        typedef decltype(policy) Movement;
+
+        // A mapped board is read-only
+        if (board)
+            run_queries<Movement>(*board, queries, options, out);
+        else
+            run_queries<Movement>(std::as_const(mapped), queries, options,
+                out);
+    });
+
+    return 0;
+}
@@ -15,40 +15,59 @@
  * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <algorithm>        /* std::reverse */
-#include <iostream>         /* printf */
+#include <algorithm>        /* std::fill, std::remove */
 
 #include "Board.h"
 
 using namespace graph;
 
-std::array<Location, N_DIRS> Board::DIRS = {
-    /* East, West, North, South */
-    Location{1, 0}, Location{-1, 0},
-    Location{0, -1}, Location{0, 1},
-#ifdef ALLOW_DIAGONALS
-    /* North-east, north-west, south-east, south-west */
-    Location{1, -1}, Location{-1, -1},
-    Location{1, -1}, Location{-1, 1}
-#endif
-};
-
 Board::Board(int rows_, int columns_)
 {
     this->rows = rows_;
     this->columns = columns_;
+    this->stride = columns_ + 2;
+
+    start = {0, 0};
+    goal = {0, 0};
+
+    neighbor_order = NeighborOrder::alternating;
+
+    initCells();
+}
+
+Board::Board(const Board& other)
+: rows(other.rows), columns(other.columns),
+  start(other.start), goal(other.goal),
+  neighbor_order(other.neighbor_order),
+  stride(other.stride), cells(other.cells) {}
+
+Board& Board::operator= (const Board& other)
+{
+    if (this == &other)
+        return *this;
+
+    rows = other.rows;
+    columns = other.columns;
+    start = other.start;
+    goal = other.goal;
+    neighbor_order = other.neighbor_order;
+    stride = other.stride;
+    cells = other.cells;
+
+    for (BoardListener* listener : listeners)
+        listener->boardCleared();
+
+    return *this;
 }
 
-bool Board::in_bounds(const Location position) const
+int Board::getRows() const
 {
-    return position.x >= 0 && position.x < columns 
-        && position.y >= 0 && position.y < rows;
+    return this->rows;
 }
 
-bool Board::passable(const Location position) const
+int Board::getColumns() const
 {
-    // position is NOT a wall (not in the set)
-    return walls.find(position) == walls.end();
+    return this->columns;
 }
 
 bool Board::isStartGoal(const Location position) const
@@ -57,38 +76,44 @@ bool Board::isStartGoal(const Location position) const
     return position == start || position == goal;
 }
 
-std::vector<Location> Board::neighbors(const Location position) const
+double Board::cost(const Location from, const Location to) const
 {
-    std::vector<Location> results;
-    Location next = {0, 0};
+    double weight = (cells[cellIndex(to)] & CELL_WEIGHT) ? 5 : 1;
 
-    for(Location direction : DIRS) {
-        next.x = position.x + direction.x;
-        next.y = position.y + direction.y;
+    // Entering a cell diagonally covers sqrt(2) times the distance
+    return (from.x != to.x && from.y != to.y) ? weight * DIAGONAL_STEP : weight;
+}
 
-        if (in_bounds(next) && passable(next)) {
-            results.push_back(next);
-        }
-    }
 
-    if ((position.x + position.y) % 2 == 0) {
-        // Make paths look nicer
-        std::reverse(results.begin(), results.end());
-    }
+void Board::clear()
+{
+    initCells();
 
-    return results;
+    for (BoardListener* listener : listeners)
+        listener->boardCleared();
 }
 
-double Board::cost(const Location from, const Location to) const
+void Board::addListener(BoardListener* listener)
 {
-    return weights.find(to) != weights.end() ? 5 : 1;
+    listeners.push_back(listener);
 }
 
+void Board::removeListener(BoardListener* listener)
+{
+    listeners.erase(
+        std::remove(listeners.begin(), listeners.end(), listener),
+        listeners.end()
+    );
+}
 
-void Board::clear()
+void Board::setNeighborOrder(const NeighborOrder order)
+{
+    neighbor_order = order;
+}
+
+Board::NeighborOrder Board::getNeighborOrder() const
 {
-    walls.clear();
-    weights.clear();
+    return neighbor_order;
 }
 
 const Location& Board::getStart() const
@@ -132,7 +157,11 @@ bool Board::setWall(const Location position)
     if (!in_bounds(position) || isStartGoal(position))
         return false;
 
-    walls.insert(position);
+    std::uint8_t& cell = cells[cellIndex(position)];
+    std::uint8_t before = cell;
+
+    cell |= CELL_WALL;
+    notify(position, before);
 
     return true;
 }
@@ -142,7 +171,11 @@ bool Board::setWeight(const Location position)
     if (!in_bounds(position))
         return false;
 
-    weights.insert(position);
+    std::uint8_t& cell = cells[cellIndex(position)];
+    std::uint8_t before = cell;
+
+    cell |= CELL_WEIGHT;
+    notify(position, before);
 
     return true;
 }
@@ -152,15 +185,18 @@ bool Board::setEmpty(const Location position)
     if (!in_bounds(position))
         return false;
 
-    std::unordered_set<Location>::iterator search;
+    std::uint8_t& cell = cells[cellIndex(position)];
+    std::uint8_t before = cell;
 
-    if ((search = walls.find(position)) != walls.end()) {
-        walls.erase(search);
+    if (cell & CELL_WALL) {
+        cell &= ~CELL_WALL;
     }
-    else if ((search = weights.find(position)) != weights.end()) {
-        weights.erase(search);
+    else {
+        cell &= ~CELL_WEIGHT;
     }
 
+    notify(position, before);
+
     return true;
 }
 
@@ -169,15 +205,20 @@ bool Board::toggleWall(const Location position)
     if (!in_bounds(position) || isStartGoal(position))
         return false;
 
-    std::unordered_set<Location>::iterator search;
-    if ((search = walls.find(position)) != walls.end()) {
-        walls.erase(search);
+    std::uint8_t& cell = cells[cellIndex(position)];
+    std::uint8_t before = cell;
+
+    if (cell & CELL_WALL) {
+        cell &= ~CELL_WALL;
     }
     else {
-        setEmpty(position);
-        setWall(position);
+        // Same as setEmpty() and setWall(), with a single notification
+        cell &= ~CELL_WEIGHT;
+        cell |= CELL_WALL;
     }
 
+    notify(position, before);
+
     return true;
 }
 
@@ -186,22 +227,31 @@ bool Board::toggleWeight(const Location position)
     if (!in_bounds(position))
         return false;
 
-    std::unordered_set<Location>::iterator search;
-    if ((search = weights.find(position)) != weights.end()) {
-        weights.erase(search);
+    std::uint8_t& cell = cells[cellIndex(position)];
+    std::uint8_t before = cell;
+
+    if (cell & CELL_WEIGHT) {
+        cell &= ~CELL_WEIGHT;
     }
     else {
-        setEmpty(position);
-        setWeight(position);
+        // Same as setEmpty() and setWeight(), with a single notification
+        cell &= ~CELL_WALL;
+        cell |= CELL_WEIGHT;
     }
 
+    notify(position, before);
+
     return true;
 }
 
 Board::ElementType Board::getElementTypeAt(const Location position) const
 {
     ElementType element = ElementType::EMPTY;
-    if (walls.find(position) != walls.end()) {
+    std::uint8_t cell = in_bounds(position) 
+        ? cells[cellIndex(position)] 
+        : (std::uint8_t) CELL_WALL;
+
+    if (cell & CELL_WALL) {
         element = ElementType::WALL;
     }
     else if (position == start) {
@@ -210,7 +260,7 @@ Board::ElementType Board::getElementTypeAt(const Location position) const
     else if (position == goal) {
         element = ElementType::GOAL;
     }
-    else if (weights.find(position) != weights.end()) {
+    else if (cell & CELL_WEIGHT) {
         element = ElementType::WEIGHT;
     }
     else {
@@ -218,4 +268,27 @@ Board::ElementType Board::getElementTypeAt(const Location position) const
     }
 
     return element;
-}
\ No newline at end of file
+}
+
+void Board::initCells()
+{
+    cells.assign((std::size_t) (rows + 2) * stride, CELL_EMPTY);
+
+    // Border of walls
+    std::fill(cells.begin(), cells.begin() + stride, CELL_WALL);
+    std::fill(cells.end() - stride, cells.end(), CELL_WALL);
+
+    for (int y = 0; y < rows; ++y) {
+        cells[cellIndex({-1, y})] = CELL_WALL;
+        cells[cellIndex({columns, y})] = CELL_WALL;
+    }
+}
+
+void Board::notify(const Location position, const std::uint8_t before)
+{
+    if (cells[cellIndex(position)] == before)
+        return;
+
+    for (BoardListener* listener : listeners)
+        listener->cellChanged(position);
+}
@@ -0,0 +1,234 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>        /* std::fill_n, std::max, std::min */
+
+#include "ChunkedBoard.h"
+
+using namespace graph;
+
+ChunkedBoard::ChunkedBoard(int rows_, int columns_)
+: rows(rows_), columns(columns_), start({0, 0}), goal({0, 0}) {}
+
+int ChunkedBoard::getRows() const
+{
+    return rows;
+}
+
+int ChunkedBoard::getColumns() const
+{
+    return columns;
+}
+
+double ChunkedBoard::cost(const Location from, const Location to) const
+{
+    double weight = (cellAt(to) == CELL_WEIGHT) ? 5 : 1;
+
+    // Entering a cell diagonally covers sqrt(2) times the distance
+    return (from.x != to.x && from.y != to.y) ? weight * DIAGONAL_STEP : weight;
+}
+
+const Location& ChunkedBoard::getStart() const
+{
+    return start;
+}
+
+const Location& ChunkedBoard::getGoal() const
+{
+    return goal;
+}
+
+bool ChunkedBoard::setStart(const Location position)
+{
+    if (!in_bounds(position))
+        return false;
+
+    setEmpty(position);
+    start = position;
+
+    return true;
+}
+
+bool ChunkedBoard::setGoal(const Location position)
+{
+    if (!in_bounds(position))
+        return false;
+
+    setEmpty(position);
+    goal = position;
+
+    return true;
+}
+
+bool ChunkedBoard::setWall(const Location position)
+{
+    if (position == start || position == goal)
+        return false;
+
+    return setCell(position, CELL_WALL);
+}
+
+bool ChunkedBoard::setWeight(const Location position)
+{
+    return setCell(position, CELL_WEIGHT);
+}
+
+bool ChunkedBoard::setEmpty(const Location position)
+{
+    return setCell(position, CELL_EMPTY);
+}
+
+void ChunkedBoard::fill(const Area& area, const Board::ElementType element)
+{
+    std::uint8_t cell = CELL_EMPTY;
+
+    if (element == Board::ElementType::WALL)
+        cell = CELL_WALL;
+    else if (element == Board::ElementType::WEIGHT)
+        cell = CELL_WEIGHT;
+
+    int left = std::max(area.top_left.x, 0);
+    int top = std::max(area.top_left.y, 0);
+    int right = std::min(area.bottom_right.x, columns);
+    int bottom = std::min(area.bottom_right.y, rows);
+
+    for (int ty = top >> TILE_BITS; ty << TILE_BITS < bottom; ++ty) {
+        for (int tx = left >> TILE_BITS; tx << TILE_BITS < right; ++tx) {
+            Area tile = {
+                {tx << TILE_BITS, ty << TILE_BITS},
+                {(tx + 1) << TILE_BITS, (ty + 1) << TILE_BITS}
+            };
+
+            bool whole = tile.top_left.x >= left && tile.top_left.y >= top
+                && tile.bottom_right.x <= right
+                && tile.bottom_right.y <= bottom;
+
+            // Start and goal must stay free
+            if (cell == CELL_WALL
+                && (tile.contains(start) || tile.contains(goal)))
+            {
+                whole = false;
+            }
+
+            if (whole) {
+                fillTile(tileKey(tile.top_left), cell);
+                continue;
+            }
+
+            for (int y = std::max(top, tile.top_left.y);
+                y < std::min(bottom, tile.bottom_right.y); ++y)
+            {
+                for (int x = std::max(left, tile.top_left.x);
+                    x < std::min(right, tile.bottom_right.x); ++x)
+                {
+                    if (cell != CELL_WALL || !(Location{x, y} == start
+                        || Location{x, y} == goal))
+                    {
+                        setCell({x, y}, cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkedBoard::compact()
+{
+    for (auto it = tiles.begin(); it != tiles.end(); ) {
+        Tile& tile = it->second;
+
+        if (tile.cells && std::all_of(tile.cells.get(),
+            tile.cells.get() + TILE_CELLS,
+            [&](std::uint8_t cell) { return cell == tile.cells[0]; }))
+        {
+            tile.uniform = tile.cells[0];
+            tile.cells.reset();
+        }
+
+        if (!tile.cells && tile.uniform == CELL_EMPTY)
+            it = tiles.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::size_t ChunkedBoard::countArrayTiles() const
+{
+    std::size_t count = 0;
+
+    for (const auto& tile : tiles)
+        count += tile.second.cells != nullptr;
+
+    return count;
+}
+
+std::size_t ChunkedBoard::countUniformTiles() const
+{
+    return tiles.size() - countArrayTiles();
+}
+
+std::size_t ChunkedBoard::memoryUsage() const
+{
+    // Per entry: the node, its key and tile, and a bucket pointer
+    std::size_t node = sizeof(void*) + sizeof(std::uint64_t) + sizeof(Tile)
+        + sizeof(void*);
+
+    return tiles.size() * node + countArrayTiles() * TILE_CELLS;
+}
+
+bool ChunkedBoard::setCell(const Location position, const std::uint8_t cell)
+{
+    if (!in_bounds(position))
+        return false;
+
+    std::uint64_t key = tileKey(position);
+    auto found = tiles.find(key);
+
+    // Already so, no array needed
+    if (cellIn(found == tiles.end() ? nullptr : &found->second, position)
+        == cell)
+    {
+        return true;
+    }
+
+    if (found == tiles.end())
+        found = tiles.emplace(key, Tile{CELL_EMPTY, nullptr}).first;
+
+    Tile& tile = found->second;
+
+    if (!tile.cells) {
+        tile.cells.reset(new std::uint8_t[TILE_CELLS]);
+        std::fill_n(tile.cells.get(), TILE_CELLS, tile.uniform);
+    }
+
+    tile.cells[cellIndex(position)] = cell;
+
+    return true;
+}
+
+void ChunkedBoard::fillTile(const std::uint64_t key, const std::uint8_t cell)
+{
+    if (cell == CELL_EMPTY) {
+        tiles.erase(key);
+        return;
+    }
+
+    Tile& tile = tiles[key];
+
+    tile.uniform = cell;
+    tile.cells.reset();
+}
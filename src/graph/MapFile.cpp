@@ -0,0 +1,216 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>          /* std::istringstream */
+#include <string>           /* std::string, std::getline */
+#include <vector>           /* std::vector */
+
+#include "MapFile.h"
+
+using namespace graph;
+
+std::unique_ptr<Board> graph::read_text_map(std::istream& in)
+{
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        lines.push_back(line);
+    }
+
+    while (!lines.empty() && lines.back().empty())
+        lines.pop_back();
+
+    if (lines.empty() || lines[0].empty())
+        return nullptr;
+
+    int rows = (int) lines.size();
+    int columns = (int) lines[0].size();
+
+    std::unique_ptr<Board> board(new Board(rows, columns));
+
+    // Walls go in last, as they can not be set on the start or the goal.
+    // Only if one was left on the top left cell can that happen
+    std::vector<Location> walls;
+
+    for (int y = 0; y < rows; ++y) {
+        if ((int) lines[y].size() != columns)
+            return nullptr;
+
+        for (int x = 0; x < columns; ++x) {
+            switch (lines[y][x]) {
+            case '.':
+                break;
+
+            case '#':
+                walls.push_back({x, y});
+                break;
+
+            case 'w':
+                board->setWeight({x, y});
+                break;
+
+            case 'S':
+                board->setStart({x, y});
+                break;
+
+            case 'G':
+                board->setGoal({x, y});
+                break;
+
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    for (const Location& wall : walls) {
+        if (!board->setWall(wall))
+            return nullptr;
+    }
+
+    return board;
+}
+
+void graph::write_text_map(std::ostream& out, const Board& board)
+{
+    for (int y = 0; y < board.getRows(); ++y) {
+        for (int x = 0; x < board.getColumns(); ++x) {
+            switch (board.getElementTypeAt({x, y})) {
+            case Board::ElementType::START:
+                out << 'S';
+                break;
+
+            case Board::ElementType::GOAL:
+                out << 'G';
+                break;
+
+            case Board::ElementType::WALL:
+                out << '#';
+                break;
+
+            case Board::ElementType::WEIGHT:
+                out << 'w';
+                break;
+
+            default:
+                out << '.';
+                break;
+            }
+        }
+
+        out << '\n';
+    }
+}
+
+std::unique_ptr<Board> graph::read_movingai_map(std::istream& in)
+{
+    std::string word, line;
+    int rows = 0, columns = 0;
+
+    // "type octile", then height and width in any order, then "map"
+    while (in >> word && word != "map") {
+        if (word == "type")
+            in >> word;
+        else if (word == "height")
+            in >> rows;
+        else if (word == "width")
+            in >> columns;
+        else
+            return nullptr;
+    }
+
+    if (!in || rows < 1 || columns < 1)
+        return nullptr;
+
+    std::getline(in, line);
+
+    std::vector<std::string> lines(rows);
+    Location first_free = {-1, -1};
+
+    for (int y = 0; y < rows; ++y) {
+        if (!std::getline(in, lines[y]))
+            return nullptr;
+
+        if (!lines[y].empty() && lines[y].back() == '\r')
+            lines[y].pop_back();
+
+        if ((int) lines[y].size() != columns)
+            return nullptr;
+
+        for (int x = 0; x < columns && first_free.x < 0; ++x) {
+            char c = lines[y][x];
+
+            if (c == '.' || c == 'G' || c == 'S')
+                first_free = {x, y};
+        }
+    }
+
+    if (first_free.x < 0)
+        return nullptr;
+
+    std::unique_ptr<Board> board(new Board(rows, columns));
+
+    // Out of the way of the walls
+    board->setStart(first_free);
+    board->setGoal(first_free);
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            char c = lines[y][x];
+
+            if (c != '.' && c != 'G' && c != 'S')
+                board->setWall({x, y});
+        }
+    }
+
+    return board;
+}
+
+bool graph::read_movingai_scenarios(
+    std::istream& in, std::vector<Scenario>& scenarios
+)
+{
+    std::string line;
+
+    if (!std::getline(in, line) || line.compare(0, 9, "version 1") != 0)
+        return false;
+
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        std::istringstream fields(line);
+        Scenario scenario;
+
+        if (!(fields >> scenario.bucket >> scenario.map
+                >> scenario.width >> scenario.height
+                >> scenario.start.x >> scenario.start.y
+                >> scenario.goal.x >> scenario.goal.y
+                >> scenario.optimal))
+        {
+            return false;
+        }
+
+        scenarios.push_back(scenario);
+    }
+
+    return true;
+}
@@ -0,0 +1,190 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>          /* std::memcmp, std::memcpy */
+#include <fstream>          /* std::ofstream */
+#include <vector>           /* std::vector */
+
+#include <fcntl.h>          /* open */
+#include <sys/mman.h>       /* mmap, munmap */
+#include <sys/stat.h>       /* fstat */
+#include <unistd.h>         /* close */
+
+#include "MappedBoard.h"
+
+using namespace graph;
+
+static const char MAGIC[8] = {'P', 'N', 'D', 'R', 'B', 'R', 'D', '1'};
+
+MappedBoard::MappedBoard()
+: mapping(nullptr), mapping_size(0), rows(0), columns(0), words(0),
+  start({0, 0}), goal({0, 0}), free_cells(nullptr), weights(nullptr) {}
+
+MappedBoard::~MappedBoard()
+{
+    close();
+}
+
+bool MappedBoard::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    void* pages = MAP_FAILED;
+
+    if (fstat(fd, &info) == 0 && (std::size_t) info.st_size >= sizeof(Header))
+        pages = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // The mapping outlives the descriptor
+    ::close(fd);
+
+    if (pages == MAP_FAILED)
+        return false;
+
+    const Header& header = *(const Header*) pages;
+    std::uint64_t words_ = ((std::uint64_t) header.columns + 63) / 64;
+    std::uint64_t plane_bytes = words_ * header.rows * sizeof(std::uint64_t);
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC))
+        || header.rows < 1 || header.columns < 1
+        || header.start_x < 0 || header.start_x >= header.columns
+        || header.start_y < 0 || header.start_y >= header.rows
+        || header.goal_x < 0 || header.goal_x >= header.columns
+        || header.goal_y < 0 || header.goal_y >= header.rows
+        || header.words != words_ || header.plane_bytes != plane_bytes
+        || (std::uint64_t) info.st_size
+            != sizeof(Header) + plane_bytes * (header.has_weights ? 2 : 1))
+    {
+        munmap(pages, info.st_size);
+        return false;
+    }
+
+    mapping = pages;
+    mapping_size = info.st_size;
+
+    rows = header.rows;
+    columns = header.columns;
+    words = words_;
+
+    start = {header.start_x, header.start_y};
+    goal = {header.goal_x, header.goal_y};
+
+    free_cells = (const std::uint64_t*) ((const char*) pages + sizeof(Header));
+    weights = header.has_weights ? free_cells + words * rows : nullptr;
+
+    return true;
+}
+
+void MappedBoard::close()
+{
+    if (mapping)
+        munmap(mapping, mapping_size);
+
+    mapping = nullptr;
+    mapping_size = 0;
+
+    rows = columns = 0;
+    words = 0;
+
+    free_cells = weights = nullptr;
+}
+
+bool MappedBoard::isOpen() const
+{
+    return mapping != nullptr;
+}
+
+bool MappedBoard::save(const std::string& filename, const Board& board)
+{
+    int rows = board.getRows(), columns = board.getColumns();
+    std::size_t words = ((std::size_t) columns + 63) / 64;
+
+    std::vector<std::uint64_t> free_plane(words * rows, 0);
+    std::vector<std::uint64_t> weight_plane(words * rows, 0);
+    bool has_weights = false;
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            std::size_t word = y * words + (x >> 6);
+            std::uint64_t mask = (std::uint64_t) 1 << (x & 63);
+
+            if (board.passable({x, y}))
+                free_plane[word] |= mask;
+
+            // Weights under walls are lost, as nothing can step on them
+            if (board.passable({x, y}) && board.cost({x, y}, {x, y}) > 1) {
+                weight_plane[word] |= mask;
+                has_weights = true;
+            }
+        }
+    }
+
+    Header header = {
+        {},
+        rows, columns,
+        board.getStart().x, board.getStart().y,
+        board.getGoal().x, board.getGoal().y,
+        has_weights,
+        (std::uint32_t) words,
+        free_plane.size() * sizeof(std::uint64_t)
+    };
+
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+    std::ofstream file(filename, std::ios::binary);
+
+    file.write((const char*) &header, sizeof(header));
+    file.write((const char*) free_plane.data(), header.plane_bytes);
+
+    if (has_weights)
+        file.write((const char*) weight_plane.data(), header.plane_bytes);
+
+    return (bool) file;
+}
+
+int MappedBoard::getRows() const
+{
+    return rows;
+}
+
+int MappedBoard::getColumns() const
+{
+    return columns;
+}
+
+double MappedBoard::cost(const Location from, const Location to) const
+{
+    double weight = (weights && bit(weights, to)) ? 5 : 1;
+
+    // Entering a cell diagonally covers sqrt(2) times the distance
+    return (from.x != to.x && from.y != to.y) ? weight * DIAGONAL_STEP : weight;
+}
+
+const Location& MappedBoard::getStart() const
+{
+    return start;
+}
+
+const Location& MappedBoard::getGoal() const
+{
+    return goal;
+}
@@ -19,7 +19,6 @@
 #include <cmath>            /* std::round */
 #include <cstdlib>          /* std::abs ; std::rand */
 #include <ctime>            /* std::time */
-#include <stdexcept>        /* std::out_of_range */
 
 #include <ncurses.h>
 
@@ -70,13 +69,17 @@ using namespace tui;
 #define DIGIT_TO_CHAR(n)  ('0' + (n))
 
 Board::Board(Corners corners_, int board_rows_, int board_cols_)
-: Window(corners_), board(board_cols_, board_rows_)
+: Window(corners_), board(board_rows_, board_cols_), components(board),
+  planners(board, board, board)
 {
     board_rows = board_rows_;
     board_cols = board_cols_;
 
     cursor = {0, 0};
 
+    data.search.resize(board_rows, board_cols);
+    data.max_cost = 0;
+
     // Random seed
     std::srand(std::time(nullptr));
 
@@ -200,10 +203,10 @@ bool Board::resetBoard()
 
 bool Board::clearData()
 {
-    data.direction.clear();
-    data.cost.clear();
+    data.search.reset();
     data.path.clear();
     data.max_cost = 0;
+    data.from_flow_field = false;
 
     return true;
 }
@@ -221,6 +224,11 @@ const graph::Board& Board::getBoard()
     return this->board;
 }
 
+Components<graph::EightWay>& Board::getComponents()
+{
+    return this->components;
+}
+
 BoardData& Board::getBoardData()
 {
     return this->data;
@@ -266,50 +274,48 @@ chtype Board::getDataElementTypeAt(
 {
     double current_cost = 0;        // Must be defined outside switch
     graph::Location next = {0, 0};
+    bool toward = false;
 
     chtype symbol = SYMBOL_EMPTY;
 
     switch (to_show) {
     case TuiAnswerShow::cost:
-        if(data.cost.empty()) {
+        if(data.search.empty()) {
             break;
         }
 
-        try {
-            current_cost = data.cost.at((graph::Location) position);
+        if (data.search.visited(position)) {
+            current_cost = data.search.costSoFar(position);
             symbol = DIGIT_TO_CHAR((int) NORMALIZE_COST_0TO9(current_cost));
         }
-        catch (std::out_of_range& e) {
-            symbol = SYMBOL_EMPTY;
-        }
         break;
     case TuiAnswerShow::came_from:          // Fallsthrough
     case TuiAnswerShow::going_to:
-        if(data.direction.empty()) {
+        if(data.search.empty()) {
             break;
         }
-        try {
-            next = data.direction.at((graph::Location) position);
+        if (data.search.visited(position)) {
+            next = data.search.cameFrom(position);
+
+            // Arrows point at came_from when showing it, away from it when
+            // showing where the search went. A flow field's came_from is
+            // already where it goes
+            toward = (to_show == TuiAnswerShow::came_from)
+                != data.from_flow_field;
+
             if (next.x == position.x + 1) {
-                symbol = (to_show == TuiAnswerShow::came_from)
-                            ? SYMBOL_ARROW_RIGHT : SYMBOL_ARROW_LEFT;
+                symbol = toward ? SYMBOL_ARROW_RIGHT : SYMBOL_ARROW_LEFT;
             }
             else if (next.x == position.x - 1) {
-                symbol = (to_show == TuiAnswerShow::came_from)
-                            ? SYMBOL_ARROW_LEFT : SYMBOL_ARROW_RIGHT; 
+                symbol = toward ? SYMBOL_ARROW_LEFT : SYMBOL_ARROW_RIGHT; 
             }
             else if (next.y == position.y + 1) {
-                symbol = (to_show == TuiAnswerShow::came_from)
-                            ? SYMBOL_ARROW_DOWN : SYMBOL_ARROW_UP;
+                symbol = toward ? SYMBOL_ARROW_DOWN : SYMBOL_ARROW_UP;
             }
             else if (next.y == position.y - 1) {
-                symbol = (to_show == TuiAnswerShow::came_from)
-                            ? SYMBOL_ARROW_UP : SYMBOL_ARROW_DOWN;
+                symbol = toward ? SYMBOL_ARROW_UP : SYMBOL_ARROW_DOWN;
             }
         }
-        catch (std::out_of_range& e) {
-            symbol = SYMBOL_EMPTY;
-        }
         break;
     case TuiAnswerShow::path:
         if  (find(data.path.begin(), 
@@ -383,11 +389,18 @@ ColorPairs Board::getColorPairFor (const chtype symbol) const
 
 void Board::updateDataStruct()
 {
-    if (!data.cost.empty() && data.max_cost == 0) {
+    if (!data.search.empty() && data.max_cost == 0) {
         // Update max_cost data
-        for(const auto& kv : data.cost) {
-            if (data.max_cost < kv.second)
-                data.max_cost = kv.second;
+        for (int y = 0; y < board_rows; ++y) {
+            for (int x = 0; x < board_cols; ++x) {
+                graph::Location position = {x, y};
+
+                if (data.search.visited(position)
+                    && data.max_cost < data.search.costSoFar(position))
+                {
+                    data.max_cost = data.search.costSoFar(position);
+                }
+            }
         }
     }
 }
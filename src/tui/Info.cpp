@@ -0,0 +1,86 @@
+/* Copyright (C) Martín E. Zahnd
+ * This file is part of Pinder.
+ *
+ * Pinder is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Pinder is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <ncurses.h>
+
+#include "../algorithms/SearchStats.h"
+
+#include "Info.h"
+
+
+using namespace tui;
+
+
+// Label column width, values are right aligned after it
+#define LABEL_WIDTH     16
+#define VALUE_WIDTH     (MENU_WIDTH - LABEL_WIDTH - 2)
+
+#define KIB             1024.0
+#define MIB             (1024.0 * 1024.0)
+
+
+Info::Info(Corners corners_)
+: Window(corners_)
+{
+}
+
+void Info::draw(bool active, void* opt)
+{
+    WINDOW* subwin_ptr = getSubWindowPointer();
+    const SearchStats* stats = (const SearchStats*) opt;
+
+    werase(subwin_ptr);
+    wattrset(subwin_ptr, COLOR_PAIR(ColorPairs_DEFAULT));
+
+    if (stats == nullptr) {
+        mvwaddstr(subwin_ptr, 0, 0, "No search statistics");
+        drawBorder(active);
+
+        this->refresh();
+        return;
+    }
+
+    mvwprintw(subwin_ptr, 0, 0, "%-*s%*zu", LABEL_WIDTH, "Expanded",
+        VALUE_WIDTH, stats->expanded);
+    mvwprintw(subwin_ptr, 1, 0, "%-*s%*zu", LABEL_WIDTH, "Pushes",
+        VALUE_WIDTH, stats->pushes);
+    mvwprintw(subwin_ptr, 2, 0, "%-*s%*zu", LABEL_WIDTH, "Pops",
+        VALUE_WIDTH, stats->pops);
+    mvwprintw(subwin_ptr, 3, 0, "%-*s%*zu", LABEL_WIDTH, "Duplicate pops",
+        VALUE_WIDTH, stats->duplicate_pops);
+    mvwprintw(subwin_ptr, 4, 0, "%-*s%*zu", LABEL_WIDTH, "Peak frontier",
+        VALUE_WIDTH, stats->peak_frontier);
+
+    if (stats->bytes < MIB)
+        mvwprintw(subwin_ptr, 5, 0, "%-*s%*.1f KiB", LABEL_WIDTH, "Memory",
+            VALUE_WIDTH - 4, stats->bytes / KIB);
+    else
+        mvwprintw(subwin_ptr, 5, 0, "%-*s%*.1f MiB", LABEL_WIDTH, "Memory",
+            VALUE_WIDTH - 4, stats->bytes / MIB);
+
+    mvwprintw(subwin_ptr, 6, 0, "%-*s%*.3f ms", LABEL_WIDTH, "Time",
+        VALUE_WIDTH - 3, stats->seconds * 1000);
+
+    drawBorder(active);
+
+    this->refresh();
+}
+
+bool Info::userInput(const int key, bool& redraw, void* opt)
+{
+    return false;
+}
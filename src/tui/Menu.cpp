@@ -36,6 +36,11 @@ const char *choices[] = {
     "A*",
     "BFS",
     "Dijkstra",
+    "JPS",
+    "D* Lite",
+    "Flow field",
+    "Change movement",
+    "Animate search",
     "Show path",
     "Show previous location",
     "Show following location",
@@ -15,15 +15,16 @@
  * along with Pinder.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cstdlib>          /* std::abs (int), printf */
+#include <chrono>           /* std::chrono */
+#include <cstdlib>          /* printf */
+#include <future>           /* std::async, std::future */
+#include <thread>           /* std::this_thread */
 #include <locale.h>         /* setlocale */
 #include <ncurses.h>
 
-#ifdef ALLOW_DIAGONALS
-#include <cmath>            /* std::sqrt */
-#endif
-
+#include "../algorithms/heuristics.h"
 #include "../algorithms/search_algorithm.h"
+#include "../graph/BoardView.h"
 
 
 #include "Tui.h"
@@ -36,6 +37,13 @@ using namespace tui;
 #define INFO_TXT_BOARD      "Arrows: Move; S: Start; G: Goal; W: Wall; H: Heavy path; C: Clear location"
 #define INFO_TXT_MENU       "Up/Down arrow: Move; Enter: Select"
 
+// How often input and progress are checked while a search runs
+#define SEARCH_POLL_MS      50
+
+// An animated search floods the whole board in about ANIMATION_FRAMES
+#define ANIMATION_FPS       30
+#define ANIMATION_FRAMES    90
+
 
 #define WINDOW_MIN_HEIGHT   (board_rows * CURSOR_Y_OFFSET                   \
                             + 2 * BORDER_PADDING + INSTRUCTIONS_HEIGHT)
@@ -56,24 +64,70 @@ using namespace tui;
 
 
 namespace tui {
-    inline int abs(int n)
+    const char* movementName(const graph::Movement movement)
     {
-        return (n > 0) ? n : -1 * n;
+        switch (movement) {
+        case graph::Movement::four_way:
+            return "4-way";
+
+        case graph::Movement::eight_way_no_corner_cutting:
+            return "8-way, no corner cutting";
+
+        case graph::Movement::eight_way:    /* Fallsthrough */
+        default:
+            return "8-way";
+        }
     }
 
-#ifdef ALLOW_DIAGONALS
-    inline double heuristic(const graph::Location a, const graph::Location b)
-#else
-    inline double heuristic(const graph::Location a, const graph::Location b)
-#endif
+    // Shows progress until searching is done. Any key cancels it
+    void waitForSearch(std::future<bool>& searching, SearchControl& control)
     {
+        timeout(0);
+
+        while (searching.wait_for(std::chrono::milliseconds(SEARCH_POLL_MS))
+            != std::future_status::ready)
+        {
+            if (getch() != ERR)
+                control.cancel();
 
-#ifdef ALLOW_DIAGONALS
-        return std::sqrt(abs(a.x - b.x) + abs(a.y - b.y));
-#else
-        return abs(a.x - b.x) + abs(a.y - b.y);
-#endif
+            move(LINES - 3, 1);
+            clrtoeol();
 
+            if (control.cancelled())
+                addstr("Cancelling...");
+            else
+                printw("Searching: %zu nodes expanded. Any key cancels",
+                    control.expanded());
+
+            refresh();
+        }
+
+        timeout(-1);
+    }
+
+    // Steps search a frame at a time, calling draw after each. Any key skips
+    // to the end
+    template<typename Search, typename Draw>
+    void animateSearch(Search& search, std::size_t frame_steps, Draw draw)
+    {
+        const std::chrono::milliseconds frame(1000 / ANIMATION_FPS);
+        auto next_frame = std::chrono::steady_clock::now();
+
+        timeout(0);
+
+        while (!search.step(frame_steps)) {
+            if (getch() != ERR) {
+                search.run();
+                break;
+            }
+
+            draw(search);
+
+            next_frame += frame;
+            std::this_thread::sleep_until(next_frame);
+        }
+
+        timeout(-1);
     }
 }
 
@@ -196,15 +250,24 @@ Tui::Tui(int board_rows_, int board_cols_)
 
 
     // Windows and Panels
-    Corners board_corners, menu_corners;
+    Corners board_corners, menu_corners, info_corners;
 
-    calculateWindowsCorners(board_corners, menu_corners);
+    calculateWindowsCorners(board_corners, menu_corners, info_corners);
+
+    // First, so it is never above the window being used
+    window_info = (info_corners.bottom_right.y
+            <= LINES - INSTRUCTIONS_HEIGHT)
+        ? new Info(info_corners)
+        : nullptr;
+    has_stats = false;
 
     window_menu = new Menu(menu_corners);
     window_board = new Board(board_corners, board_rows, board_cols);
 
     // Defaults
     data_to_display = TuiAnswerShow::path;
+    movement = graph::Movement::eight_way;
+    animate = false;
 
     update_panels();
 }
@@ -215,6 +278,7 @@ Tui::~Tui()
 
     delete window_board;
     delete window_menu;
+    delete window_info;
     endwin();
 }
 
@@ -229,6 +293,7 @@ void Tui::show()
 
     DRAW_WINDOW(board);
     DRAW_WINDOW(menu);
+    drawInfo();
     drawstdscr();
 
     update_panels();
@@ -278,6 +343,31 @@ void Tui::show()
                 runAlgorithm(Tui::AvailableAlgorithms::dijkstra);
                 break;
 
+            case Menu::AvailableOptions::jps:
+                runAlgorithm(Tui::AvailableAlgorithms::jps);
+                break;
+
+            case Menu::AvailableOptions::dstar_lite:
+                runAlgorithm(Tui::AvailableAlgorithms::dstar_lite);
+                break;
+
+            case Menu::AvailableOptions::flow_field:
+                runAlgorithm(Tui::AvailableAlgorithms::flow_field);
+                break;
+
+            case Menu::AvailableOptions::toggle_movement:
+                nextMovement();
+                window_board->clearData();
+
+                DRAW_WINDOW(board);
+                drawstdscr();
+                break;
+
+            case Menu::AvailableOptions::toggle_animation:
+                animate = !animate;
+                drawstdscr();
+                break;
+
             case Menu::AvailableOptions::toggle_path:
                 data_to_display = TuiAnswerShow::path;
                 DRAW_WINDOW(board);
@@ -351,7 +441,16 @@ void Tui::drawstdscr()
         break;
     }
 
-    mvaddstr(LINES - 2, 1, "TAB: Change window. F1, F2: Exit");
+    move(LINES - 2, 1);
+    clrtoeol();
+    printw("TAB: Change window. F1, F2: Exit. Movement: %s%s",
+        movementName(movement), animate ? ". Animated" : "");
+}
+
+void Tui::drawInfo()
+{
+    if (window_info != nullptr)
+        window_info->draw(false, has_stats ? &last_search : nullptr);
 }
 
 bool Tui::userInput(const int key, bool& redraw, bool& exit)
@@ -386,7 +485,9 @@ bool Tui::userInput(const int key, bool& redraw, bool& exit)
     return true;
 }
 
-void Tui::calculateWindowsCorners(Corners& board, Corners& menu)
+void Tui::calculateWindowsCorners(
+    Corners& board, Corners& menu, Corners& info
+)
 {
     int max_col = 0, max_row = 0;
     getmaxyx(stdscr, max_row, max_col);
@@ -406,57 +507,210 @@ void Tui::calculateWindowsCorners(Corners& board, Corners& menu)
         + board_rows * CURSOR_Y_OFFSET + 2 * BORDER_PADDING;
 
 
+    // The menu and the info panel under it are centered together, or the
+    // menu alone if there is no room for both
+    int column_height = MENU_HEIGHT + 2 * BORDER_PADDING
+        + INFO_HEIGHT + 2 * BORDER_PADDING;
+
+    if (column_height > max_row - INSTRUCTIONS_HEIGHT)
+        column_height = MENU_HEIGHT + 2 * BORDER_PADDING;
+
     menu.top_left.x = board.bottom_right.x + WINDOW_SEPARATION;
-    menu.top_left.y = (max_row 
-        - MENU_HEIGHT - 2 * BORDER_PADDING
-        - INSTRUCTIONS_HEIGHT
-    ) / 2;
+    menu.top_left.y = (max_row - column_height - INSTRUCTIONS_HEIGHT) / 2;
 
     menu.bottom_right.x = menu.top_left.x
         + MENU_WIDTH + 2 * BORDER_PADDING;
     menu.bottom_right.y = menu.top_left.y
         + MENU_HEIGHT + 2 * BORDER_PADDING;
+
+
+    info.top_left.x = menu.top_left.x;
+    info.top_left.y = menu.bottom_right.y;
+
+    info.bottom_right.x = menu.bottom_right.x;
+    info.bottom_right.y = info.top_left.y
+        + INFO_HEIGHT + 2 * BORDER_PADDING;
 }
 
 bool Tui::runAlgorithm(Tui::AvailableAlgorithms algorithm)
 {
     bool path_found = false;
-    BoardData& board_data = window_board->getBoardData();
+    SearchControl control;
 
     window_board->clearData();
+    has_stats = false;
+
+    // Start and goal in different regions: no need to flood either of them.
+    // 8-way components only catch what every policy agrees on
+    if (!window_board->getComponents().connected(
+            window_board->getBoard().getStart(),
+            window_board->getBoard().getGoal()))
+    {
+        DRAW_WINDOW(board);
+        drawInfo();
+        return false;
+    }
 
-    switch(algorithm) {
+    if (animate) {
+        // Drawn as it goes, and curses is not thread safe
+        path_found = searchBoard(algorithm, control);
+    }
+    else {
+        // On another thread, so the terminal keeps answering. Nothing else
+        // touches the board until it is done
+        std::future<bool> searching = std::async(std::launch::async, [&] {
+            return searchBoard(algorithm, control);
+        });
+
+        waitForSearch(searching, control);
+        path_found = searching.get();
+    }
+
+    // Half a search is not worth showing
+    if (control.cancelled()) {
+        window_board->clearData();
+        has_stats = false;
+        path_found = false;
+    }
+
+    DRAW_WINDOW(board);
+    drawInfo();
+    drawstdscr();
+
+    return path_found;
+}
+
+bool Tui::searchBoard(
+    Tui::AvailableAlgorithms algorithm, SearchControl& control
+)
+{
+    BoardData& board_data = window_board->getBoardData();
+
+    return graph::dispatch_movement(movement, [&](auto policy) {
+        typedef decltype(policy) Movement;
+
+        typedef typename MatchedHeuristic<Movement>::type Heuristic;
+
+        typedef graph::BoardView<Movement> View;
+
+        View view(window_board->getBoard());
+
+        // A few expansions per frame. Drawn as arrows: there is no path yet
+        // and costs are still growing
+        auto animate_board = [&](auto engine) {
+            TuiAnswerShow shown = TuiAnswerShow::going_to;
+
+            if (data_to_display == TuiAnswerShow::came_from)
+                shown = TuiAnswerShow::came_from;
+
+            ResumableSearch<decltype(engine), View, BoardWorkspace>
+                steps(view, board_data.search, engine);
+
+            animateSearch(
+                steps,
+                board_rows * board_cols / ANIMATION_FRAMES + 1,
+                [&](const auto& steps) {
+                    window_board->draw(IS_ACTIVE(board), &shown);
+
+                    move(LINES - 3, 1);
+                    clrtoeol();
+                    printw("Animating: %zu nodes expanded. Any key skips",
+                        steps.expanded());
+
+                    update_panels();
+                    doupdate();
+                }
+            );
+        };
+
+        // Every best-first engine runs the same way: counted, reporting
+        // progress and cancellable
+        auto search = [&](auto engine) {
+            auto counted = engine
+                .withStop(Cancellable<StopAtGoal>(control))
+                .withSink(ProgressSink<StatsSink>(
+                    control, StatsSink(last_search)
+                ));
+
+            if (animate)
+                animate_board(counted);
+            else
+                counted(view, board_data.search);
+
+            has_stats = true;
+        };
+
+        switch(algorithm) {
         case Tui::AvailableAlgorithms::astar:
-        a_star_search(
-            window_board->getBoard(),
-            board_data.direction,
-            board_data.cost,
-            &heuristic
+            search(AStarSearch<Heuristic>());
+            break;
+
+        case Tui::AvailableAlgorithms::bfs:
+            search(BreadthFirstSearch());
+            break;
+
+        case Tui::AvailableAlgorithms::dijkstra:
+            search(DijkstraSearch());
+            break;
+
+        case Tui::AvailableAlgorithms::jps:
+            // Jump Point Search needs diagonals, 4-way falls back to A*
+            if constexpr (Movement::diagonals)
+                search(JumpPointSearch<Heuristic>());
+            else
+                search(AStarSearch<Heuristic>());
+            break;
+
+        case Tui::AvailableAlgorithms::dstar_lite:
+            // Only repairs what changed since the last run. If cancelled,
+            // the next run carries on from there
+            window_board->template getPlanner<Movement>().plan(
+                view.getStart(),
+                view.getGoal(),
+                &control
+            );
+
+            if (control.cancelled())
+                return false;
+
+            window_board->template getPlanner<Movement>().exportPath(
+                board_data.search
+            );
+            break;
+
+        case Tui::AvailableAlgorithms::flow_field:
+            // One search from the goal, shown as where each cell goes next
+            if (!board_data.flow.build(view, &control))
+                return false;
+
+            board_data.flow.exportTo(board_data.search);
+            board_data.from_flow_field = true;
+
+            return board_data.flow.path(view.getStart(), board_data.path);
+        }
+
+        return search_reconstruct_path(
+            view,
+            board_data.search,
+            board_data.path
         );
+    });
+}
+
+void Tui::nextMovement()
+{
+    switch (movement) {
+    case graph::Movement::four_way:
+        movement = graph::Movement::eight_way;
         break;
 
-    case Tui::AvailableAlgorithms::bfs:
-        breadth_first_search(
-            window_board->getBoard(),
-            board_data.direction
-        );
+    case graph::Movement::eight_way:
+        movement = graph::Movement::eight_way_no_corner_cutting;
         break;
 
-    case Tui::AvailableAlgorithms::dijkstra:
-        dijkstra_search(
-            window_board->getBoard(),
-            board_data.direction,
-            board_data.cost
-        );
+    case graph::Movement::eight_way_no_corner_cutting: /* Fallsthrough */
+    default:
+        movement = graph::Movement::four_way;
         break;
     }
-
-    path_found = search_reconstruct_path(
-        window_board->getBoard(),
-        board_data.direction,
-        board_data.path
-    );
-    DRAW_WINDOW(board);
-
-    return path_found;
-}
\ No newline at end of file
+}